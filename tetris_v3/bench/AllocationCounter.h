@@ -0,0 +1,90 @@
+#pragma once
+
+/**
+ * @file AllocationCounter.h
+ * @brief Counting replacement of the global allocation functions
+ *
+ * Include from exactly one translation unit of a benchmark executable.
+ * Every global operator new bumps a relaxed atomic counter, so a benchmark
+ * can read the count before and after a section and report allocations.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace Tetris {
+namespace Bench {
+
+inline std::atomic<uint64_t> g_allocation_count{0};
+
+/**
+ * @brief Number of global allocations performed so far by the whole process
+ */
+inline uint64_t allocationCount() noexcept {
+    return g_allocation_count.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Free memory from any of the allocation functions below
+ *
+ * Kept out of line: once an operator delete calling free() is inlined next
+ * to a new-expression, GCC reports the pair as mismatched.
+ */
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+inline void releaseAllocation(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+} // namespace Bench
+} // namespace Tetris
+
+void* operator new(std::size_t size) {
+    Tetris::Bench::g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    Tetris::Bench::g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return ::operator new(size, tag);
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    Tetris::Bench::g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t alignment = static_cast<std::size_t>(align);
+    const std::size_t rounded = (size + alignment - 1) / alignment * alignment;
+    if (void* ptr = std::aligned_alloc(alignment, rounded ? rounded : alignment)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t align) {
+    return ::operator new(size, align);
+}
+
+void operator delete(void* ptr) noexcept { Tetris::Bench::releaseAllocation(ptr); }
+void operator delete[](void* ptr) noexcept { Tetris::Bench::releaseAllocation(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { Tetris::Bench::releaseAllocation(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { Tetris::Bench::releaseAllocation(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { Tetris::Bench::releaseAllocation(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { Tetris::Bench::releaseAllocation(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { Tetris::Bench::releaseAllocation(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { Tetris::Bench::releaseAllocation(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { Tetris::Bench::releaseAllocation(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { Tetris::Bench::releaseAllocation(ptr); }
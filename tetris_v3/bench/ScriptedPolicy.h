@@ -0,0 +1,131 @@
+#pragma once
+
+/**
+ * @file ScriptedPolicy.h
+ * @brief Scripted player shared by the headless game benchmarks
+ *
+ * For each new piece the policy picks the rotation and column where the
+ * piece lands lowest, then sends one action per tick: rotate, walk to the
+ * column, drop, while gravity runs on the same ticks. With Odds set it
+ * also varies its play from its own Pcg32 (a random legal spot, a hold
+ * first, a soft drop to the lock), so more of the engine stays on the
+ * measured path. Either way the actions are a pure function of the game
+ * and the policy's seed, so a replayed game must end the same.
+ */
+
+#include "GameSimulation.h"
+#include "Random.h"
+#include <array>
+#include <cstdint>
+
+namespace Tetris {
+namespace Bench {
+
+class ScriptedPolicy {
+public:
+    /**
+     * @brief Chances of departing from the lowest hard drop, each 1 in N (0 = never)
+     */
+    struct Odds {
+        uint32_t random_spot{0};                 // Any legal rotation and column instead
+        uint32_t hold{0};                        // Hold first (when allowed)
+        uint32_t soft_drop{0};                   // Soft drop to the lock instead of hard dropping
+    };
+
+    ScriptedPolicy() = default;
+    explicit ScriptedPolicy(const Odds& odds) : odds_(odds) {}
+
+    /**
+     * @brief Forget the current plan and reseed (call after GameSimulation::newGame)
+     * @param seed Seed for the policy's choices
+     * @param stream Stream for the policy's choices (e.g. the game index)
+     */
+    void newGame(uint64_t seed = 0, uint64_t stream = 0) noexcept {
+        rng_ = Pcg32(seed, stream);
+        planned_piece_ = -1;
+    }
+
+    /**
+     * @brief Choose the input for this tick
+     * @param sim Game to play (read only; the caller applies the action)
+     * @return Action to apply
+     */
+    [[nodiscard]] InputAction nextAction(const GameSimulation& sim) {
+        if (sim.getCounters().total_pieces != planned_piece_) {
+            planned_piece_ = sim.getCounters().total_pieces;
+            plan(sim);
+        }
+
+        const int x = sim.getCurrentPiece().getPosition().x;
+        if (plan_.hold) {
+            // Holding brings out another piece (or spawns one), which gets its own plan
+            planned_piece_ = -1;
+            return InputAction::HOLD;
+        }
+        if (rotations_done_ < plan_.rotations) {
+            rotations_done_++;
+            return InputAction::ROTATE_CW;
+        }
+        if (x > plan_.target_x) return InputAction::MOVE_LEFT;
+        if (x < plan_.target_x) return InputAction::MOVE_RIGHT;
+        return plan_.drop;
+    }
+
+private:
+    struct Plan {
+        bool hold{false};
+        int rotations{0};
+        int target_x{0};
+        InputAction drop{InputAction::HARD_DROP};
+    };
+
+    Odds odds_;
+    Pcg32 rng_;
+    Plan plan_;
+    int planned_piece_{-1};                      // total_pieces when planned (-1 = plan on the next call)
+    int rotations_done_{0};
+
+    // Lowest landing spot for the falling piece, or a random legal one
+    void plan(const GameSimulation& sim) {
+        struct Spot {
+            int rotations;
+            int x;
+        };
+        std::array<Spot, 4 * (Board::WIDTH + 2)> spots{};
+        int spot_count = 0;
+
+        const Board& board = sim.getBoard();
+        plan_ = Plan{};
+        rotations_done_ = 0;
+        int best_y = -1;
+        Tetromino piece = sim.getCurrentPiece();
+        for (int rotations = 0; rotations < 4; ++rotations) {
+            for (int x = -2; x < Board::WIDTH; ++x) {
+                const Tetromino shifted = piece.withPosition({x, piece.getPosition().y});
+                if (!board.canPlacePiece(shifted)) continue;
+                spots[spot_count++] = {rotations, x};
+                const int landing = board.findDropPosition(shifted).y;
+                if (landing > best_y) {
+                    best_y = landing;
+                    plan_.rotations = rotations;
+                    plan_.target_x = x;
+                }
+            }
+            piece.rotateClockwise();
+        }
+        if (spot_count > 0 && chance(odds_.random_spot)) {
+            const Spot& spot = spots[rng_.bounded(static_cast<uint32_t>(spot_count))];
+            plan_.rotations = spot.rotations;
+            plan_.target_x = spot.x;
+        }
+        plan_.hold = sim.canHold() && chance(odds_.hold);
+        plan_.drop = chance(odds_.soft_drop) ? InputAction::SOFT_DROP : InputAction::HARD_DROP;
+    }
+
+    [[nodiscard]] bool chance(uint32_t one_in) noexcept {
+        return one_in != 0 && rng_.bounded(one_in) == 0;
+    }
+};
+
+} // namespace Bench
+} // namespace Tetris
@@ -0,0 +1,91 @@
+/**
+ * @file alloc_check.cpp
+ * @brief Verifies that the move/rotate/drop/lock path performs no heap allocation
+ *
+ * Installs the counting global allocator, drives a GameSimulation (the same
+ * rules TetrisGame runs) through scripted gameplay ticks (shifts, kicked
+ * rotations, holds, gravity, soft and hard drops, locking, line clears,
+ * 7-bag spawning and restarts after a top out), and fails if any
+ * allocation happens once the game has reached steady state.
+ */
+
+#include "AllocationCounter.h"
+#include "GameSimulation.h"
+#include <chrono>
+#include <cstdio>
+
+using namespace Tetris;
+
+namespace {
+
+/**
+ * @brief Scripted player feeding one action per tick into a GameSimulation
+ */
+class FrameDriver {
+public:
+    FrameDriver() { sim_.newGame(2024); }
+
+    void step() {
+        ++frame_;
+        InputAction action = InputAction::NONE;
+        switch (frame_ % 8) {
+            case 0: action = InputAction::MOVE_LEFT; break;
+            case 1: action = InputAction::ROTATE_CW; break;
+            case 2: action = InputAction::MOVE_RIGHT; break;
+            case 3: action = InputAction::MOVE_RIGHT; break;
+            case 4: action = InputAction::ROTATE_CCW; break;
+            case 5: action = InputAction::SOFT_DROP; break;
+            default: break;
+        }
+        if (frame_ % 61 == 0) action = InputAction::HARD_DROP;
+        if (frame_ % 97 == 0) action = InputAction::HOLD;
+        sim_.step(action);
+
+        if (sim_.isGameOver()) {
+            // Top out: count the finished game and start over
+            pieces_ += sim_.getCounters().total_pieces;
+            lines_ += sim_.getLinesCleared();
+            sim_.newGame(static_cast<uint32_t>(frame_));
+        }
+    }
+
+    [[nodiscard]] long piecesLocked() const noexcept { return pieces_ + sim_.getCounters().total_pieces; }
+    [[nodiscard]] long linesCleared() const noexcept { return lines_ + sim_.getLinesCleared(); }
+
+private:
+    GameSimulation sim_;
+    long frame_{0};
+    long pieces_{0};
+    long lines_{0};
+};
+
+} // namespace
+
+int main() {
+    const long warmup_frames = 10000;
+    const long measured_frames = 5000000;
+
+    FrameDriver driver;
+    for (long i = 0; i < warmup_frames; ++i) driver.step();
+
+    const uint64_t before = Bench::allocationCount();
+    const auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < measured_frames; ++i) driver.step();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const uint64_t allocations = Bench::allocationCount() - before;
+
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    std::printf("%ld frames, %ld pieces, %ld lines in %.3f s (%.1f M frames/s)\n",
+                measured_frames, driver.piecesLocked(), driver.linesCleared(), seconds,
+                measured_frames / seconds / 1e6);
+    std::printf("allocations: %llu (%.6f per frame)\n",
+                static_cast<unsigned long long>(allocations),
+                static_cast<double>(allocations) / measured_frames);
+
+    if (allocations != 0) {
+        std::printf("FAIL: steady-state frames must not allocate\n");
+        return 1;
+    }
+    std::printf("OK: zero allocations per frame in steady state\n");
+    return 0;
+}
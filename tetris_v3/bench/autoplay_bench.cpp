@@ -0,0 +1,152 @@
+/**
+ * @file autoplay_bench.cpp
+ * @brief Headless AutoPlayer games: strength, decision latency and thread scaling
+ *
+ * The AutoPlayer plays fixed-seed games on a GameSimulation, one nextAction()
+ * per tick exactly as TetrisGame feeds it, capped at a number of pieces.
+ * The same games are played with 1, 2 and 4 search threads and an
+ * unlimited move budget; since candidates are ranked by a total order the
+ * games must come out identical, so any difference is reported as a
+ * failure. The 1-thread games are then replayed with a 1 MB transposition
+ * table, which must not change them either. Reports pieces per second, p50/p99 planning time per piece,
+ * lines per game, the share of placements scored from the table and
+ * allocations per decision once warm, then repeats the
+ * games with a tight budget to show the cut-off in action.
+ */
+
+#include "AllocationCounter.h"
+#include "AutoPlayer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace Tetris;
+
+namespace {
+
+struct GameResult {
+    int lines{0};
+    int pieces{0};
+    int score{0};
+    bool operator==(const GameResult& other) const {
+        return lines == other.lines && pieces == other.pieces && score == other.score;
+    }
+};
+
+struct RunResult {
+    std::vector<GameResult> games;
+    std::vector<double> think_ms;       // One entry per planning call
+    double seconds{0};
+    uint64_t allocations{0};            // During decisions after the first game
+    uint64_t warm_decisions{0};
+    AutoPlayer::Stats stats;
+};
+
+RunResult playGames(const AutoPlayer::Config& config, int games, int max_pieces) {
+    RunResult run;
+    AutoPlayer player(config);
+    GameSimulation sim;
+    const auto start = std::chrono::steady_clock::now();
+    for (int g = 0; g < games; ++g) {
+        sim.newGame(static_cast<uint64_t>(g) + 1);
+        player.reset();
+        while (!sim.isGameOver() && sim.getCounters().total_pieces <= max_pieces) {
+            const uint64_t decisions = player.getStats().decisions;
+            const uint64_t allocations = Bench::allocationCount();
+            const auto before = std::chrono::steady_clock::now();
+            const InputAction action = player.nextAction(sim);
+            const auto after = std::chrono::steady_clock::now();
+            if (player.getStats().decisions != decisions) {
+                run.think_ms.push_back(std::chrono::duration<double, std::milli>(after - before).count());
+                if (g > 0) {
+                    run.allocations += Bench::allocationCount() - allocations;
+                    run.warm_decisions++;
+                }
+            }
+            sim.step(action);
+        }
+        run.games.push_back({sim.getLinesCleared(), sim.getCounters().total_pieces, sim.getScore()});
+    }
+    run.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    run.stats = player.getStats();
+    return run;
+}
+
+double percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0;
+    const size_t index = std::min(values.size() - 1, static_cast<size_t>(p * static_cast<double>(values.size())));
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+    return values[index];
+}
+
+void report(const char* label, const RunResult& run) {
+    long pieces = 0;
+    std::vector<int> lines;
+    for (const auto& game : run.games) {
+        pieces += game.pieces;
+        lines.push_back(game.lines);
+    }
+    std::sort(lines.begin(), lines.end());
+    std::printf("%-22s %7.0f pieces/s  plan p50 %6.3f ms p99 %6.3f ms  lines min %d median %d max %d"
+                "  table hits %4.1f%%  cut-offs %llu  allocs/decision %.2f\n",
+                label, static_cast<double>(pieces) / run.seconds, percentile(run.think_ms, 0.5),
+                percentile(run.think_ms, 0.99), lines.front(), lines[lines.size() / 2], lines.back(),
+                run.stats.boards_scored
+                    ? 100.0 * static_cast<double>(run.stats.table_hits) / static_cast<double>(run.stats.boards_scored)
+                    : 0.0,
+                static_cast<unsigned long long>(run.stats.budget_cutoffs),
+                run.warm_decisions ? static_cast<double>(run.allocations) / static_cast<double>(run.warm_decisions) : 0.0);
+}
+
+} // namespace
+
+int main() {
+    const int games = 6;
+    const int max_pieces = 1000;
+    bool ok = true;
+
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+
+    AutoPlayer::Config config;
+    config.move_budget = std::chrono::milliseconds(60000);
+    std::vector<GameResult> reference;
+    for (int threads : {1, 2, 4}) {
+        config.threads = threads;
+        const RunResult run = playGames(config, games, max_pieces);
+        char label[32];
+        std::snprintf(label, sizeof(label), "beam %d, %d thread%s", config.beam_width, threads, threads > 1 ? "s" : "");
+        report(label, run);
+        if (reference.empty()) {
+            reference = run.games;
+        } else if (run.games != reference) {
+            std::printf("  games differ from the 1-thread run\n");
+            ok = false;
+        }
+    }
+
+    // Cached scores equal evaluated ones, so the table only changes the speed
+    config.threads = 1;
+    config.table_megabytes = 1;
+    {
+        const RunResult run = playGames(config, games, max_pieces);
+        report("table 1 MB, 1 thread", run);
+        if (run.games != reference) {
+            std::printf("  games differ from the run without the table\n");
+            ok = false;
+        }
+    }
+    config.table_megabytes = 0;
+
+    // A budget shorter than one level leaves only the current piece's placements
+    config.threads = 1;
+    config.move_budget = std::chrono::milliseconds(0);
+    report("budget 0 ms, 1 thread", playGames(config, games, max_pieces));
+
+    config.move_budget = std::chrono::milliseconds(60000);
+    config.beam_width = 1;
+    report("beam 1, 1 thread", playGames(config, games, max_pieces));
+
+    std::printf("thread count and table independence: %s\n", ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,263 @@
+/**
+ * @file board_bench.cpp
+ * @brief Micro-benchmark of the bitboard collision, line and drop queries
+ *
+ * Compares Board's row-mask queries against the previous Cell-grid walk,
+ * and the height-based hard drop against stepping down one row at a time
+ * (both reimplemented here as references), on boards produced by random
+ * play, after checking that both give identical answers.
+ */
+
+#include "Board.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace Tetris;
+
+namespace {
+
+// --- Reference: the original Cell-grid implementation ---
+
+bool gridCanPlace(const Board::GridType& grid, const Tetromino& piece, const Position& pos, Rotation rot) {
+    if (!piece.isValid()) return false;
+    std::vector<Position> positions;
+    positions.reserve(4);
+    const auto& shape = piece.withRotation(rot).getCurrentShape();
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            if (shape[y][x]) {
+                positions.push_back({pos.x + x, pos.y + y});
+            }
+        }
+    }
+    for (const auto& p : positions) {
+        if (p.x < 0 || p.x >= Board::WIDTH || p.y < 0 || p.y >= Board::HEIGHT || grid[p.y][p.x].occupied) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool gridLineComplete(const Board::GridType& grid, int line) {
+    for (int x = 0; x < Board::WIDTH; ++x) {
+        if (grid[line][x].isEmpty()) return false;
+    }
+    return true;
+}
+
+int gridCountCompleteLines(const Board::GridType& grid) {
+    int count = 0;
+    for (int y = 0; y < Board::HEIGHT; ++y) {
+        count += gridLineComplete(grid, y);
+    }
+    return count;
+}
+
+bool gridGameOver(const Board::GridType& grid) {
+    for (int x = 0; x < Board::WIDTH; ++x) {
+        if (grid[0][x].occupied) return true;
+    }
+    return false;
+}
+
+int gridColumnHeight(const Board::GridType& grid, int column) {
+    for (int y = 0; y < Board::HEIGHT; ++y) {
+        if (grid[y][column].occupied) return Board::HEIGHT - y;
+    }
+    return 0;
+}
+
+Position steppedDropPosition(const Board& board, const Tetromino& piece) {
+    Position drop_pos = piece.getPosition();
+    while (board.canPlacePiece(piece, {drop_pos.x, drop_pos.y + 1}, piece.getRotation())) {
+        drop_pos.y++;
+    }
+    return drop_pos;
+}
+
+// --- Workload ---
+
+struct Query {
+    Tetromino piece;
+    Position pos;
+    Rotation rot;
+};
+
+std::vector<Board> makeBoards(std::mt19937& rng, int count) {
+    std::vector<Board> boards;
+    std::uniform_int_distribution<int> type_dist(0, 6);
+    std::uniform_int_distribution<int> x_dist(-1, Board::WIDTH - 2);
+    std::uniform_int_distribution<int> rot_dist(0, 3);
+    for (int i = 0; i < count; ++i) {
+        Board board;
+        const int pieces = 5 + i % 40;
+        for (int p = 0; p < pieces; ++p) {
+            Tetromino piece(static_cast<TetrominoType>(type_dist(rng)), {x_dist(rng), 0});
+            for (int r = rot_dist(rng); r > 0; --r) piece.rotateClockwise();
+            if (!board.canPlacePiece(piece)) continue;
+            piece.setPosition(board.findDropPosition(piece));
+            board.placePiece(piece);
+            if (i % 2 == 0) board.clearLines(); // Keep some full rows on odd boards
+        }
+        boards.push_back(board);
+    }
+    return boards;
+}
+
+std::vector<Query> makeQueries(std::mt19937& rng, int count) {
+    std::vector<Query> queries;
+    std::uniform_int_distribution<int> type_dist(0, 6);
+    std::uniform_int_distribution<int> x_dist(-3, Board::WIDTH);
+    std::uniform_int_distribution<int> y_dist(-2, Board::HEIGHT);
+    std::uniform_int_distribution<int> rot_dist(0, 3);
+    for (int i = 0; i < count; ++i) {
+        queries.push_back({Tetromino(static_cast<TetrominoType>(type_dist(rng))),
+                           {x_dist(rng), y_dist(rng)},
+                           static_cast<Rotation>(rot_dist(rng))});
+    }
+    return queries;
+}
+
+template <typename Fn>
+double nanosPerOp(long ops, Fn&& fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(ops);
+}
+
+void report(const char* name, double before_ns, double after_ns) {
+    std::printf("%-22s before %8.2f ns/op   after %8.2f ns/op   speedup %6.1fx\n",
+                name, before_ns, after_ns, before_ns / after_ns);
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(12345);
+    const auto boards = makeBoards(rng, 64);
+    const auto queries = makeQueries(rng, 4096);
+
+    // Drop queries start from valid positions, as the active piece always does
+    std::vector<Tetromino> drops;
+    for (const auto& q : queries) {
+        Tetromino piece = q.piece;
+        for (int r = static_cast<int>(q.rot); r > 0; --r) piece.rotateClockwise();
+        piece.setPosition(q.pos);
+        drops.push_back(piece);
+    }
+
+    // Both implementations must agree before timing means anything
+    long mismatches = 0;
+    for (const auto& board : boards) {
+        for (const auto& q : queries) {
+            mismatches += board.canPlacePiece(q.piece, q.pos, q.rot) != gridCanPlace(board.getGrid(), q.piece, q.pos, q.rot);
+        }
+        mismatches += board.countCompleteLines() != gridCountCompleteLines(board.getGrid());
+        mismatches += board.isGameOver() != gridGameOver(board.getGrid());
+        for (int x = 0; x < Board::WIDTH; ++x) {
+            mismatches += board.getColumnHeight(x) != gridColumnHeight(board.getGrid(), x);
+        }
+        mismatches += !board.verifyStats();
+        for (const auto& piece : drops) {
+            if (!board.canPlacePiece(piece)) continue;
+            mismatches += !(board.findDropPosition(piece) == steppedDropPosition(board, piece));
+        }
+    }
+    if (mismatches != 0) {
+        std::printf("bitboard and grid disagree on %ld queries\n", mismatches);
+        return 1;
+    }
+
+    const int rounds = 20;
+    const long place_ops = static_cast<long>(rounds) * static_cast<long>(boards.size() * queries.size());
+    volatile long sink = 0;
+
+    const double grid_place = nanosPerOp(place_ops, [&] {
+        long hits = 0;
+        for (int r = 0; r < rounds; ++r)
+            for (const auto& board : boards)
+                for (const auto& q : queries) hits += gridCanPlace(board.getGrid(), q.piece, q.pos, q.rot);
+        sink = sink + hits;
+    });
+    const double bit_place = nanosPerOp(place_ops, [&] {
+        long hits = 0;
+        for (int r = 0; r < rounds; ++r)
+            for (const auto& board : boards)
+                for (const auto& q : queries) hits += board.canPlacePiece(q.piece, q.pos, q.rot);
+        sink = sink + hits;
+    });
+
+    const int line_rounds = 200000;
+    const long line_ops = static_cast<long>(line_rounds) * static_cast<long>(boards.size());
+    const double grid_lines = nanosPerOp(line_ops, [&] {
+        long lines = 0;
+        for (int r = 0; r < line_rounds; ++r)
+            for (const auto& board : boards) lines += gridCountCompleteLines(board.getGrid());
+        sink = sink + lines;
+    });
+    const double bit_lines = nanosPerOp(line_ops, [&] {
+        long lines = 0;
+        for (int r = 0; r < line_rounds; ++r)
+            for (const auto& board : boards) lines += board.countCompleteLines();
+        sink = sink + lines;
+    });
+    const double grid_over = nanosPerOp(line_ops, [&] {
+        long over = 0;
+        for (int r = 0; r < line_rounds; ++r)
+            for (const auto& board : boards) over += gridGameOver(board.getGrid());
+        sink = sink + over;
+    });
+    const double bit_over = nanosPerOp(line_ops, [&] {
+        long over = 0;
+        for (int r = 0; r < line_rounds; ++r)
+            for (const auto& board : boards) over += board.isGameOver();
+        sink = sink + over;
+    });
+
+    // Hard drop from every valid query position
+    std::vector<std::pair<const Board*, Tetromino>> valid_drops;
+    for (const auto& board : boards) {
+        for (const auto& piece : drops) {
+            if (board.canPlacePiece(piece)) valid_drops.emplace_back(&board, piece);
+        }
+    }
+    const int drop_rounds = 20;
+    const long drop_ops = static_cast<long>(drop_rounds) * static_cast<long>(valid_drops.size());
+    const double stepped_drop = nanosPerOp(drop_ops, [&] {
+        long rows = 0;
+        for (int r = 0; r < drop_rounds; ++r)
+            for (const auto& d : valid_drops) rows += steppedDropPosition(*d.first, d.second).y;
+        sink = sink + rows;
+    });
+    const double height_drop = nanosPerOp(drop_ops, [&] {
+        long rows = 0;
+        for (int r = 0; r < drop_rounds; ++r)
+            for (const auto& d : valid_drops) rows += d.first->findDropPosition(d.second).y;
+        sink = sink + rows;
+    });
+
+    const double full_stats = nanosPerOp(line_ops, [&] {
+        long holes = 0;
+        for (int r = 0; r < line_rounds; ++r)
+            for (const auto& board : boards) holes += board.calculateStats().holes;
+        sink = sink + holes;
+    });
+    const double kept_stats = nanosPerOp(line_ops, [&] {
+        long holes = 0;
+        for (int r = 0; r < line_rounds; ++r)
+            for (const auto& board : boards) holes += board.stats().holes;
+        sink = sink + holes;
+    });
+
+    std::printf("%zu boards x %zu placements, results identical\n", boards.size(), queries.size());
+    std::printf("before = Cell grid walk / row-by-row drop / full stats, after = bitboard / column heights / kept stats\n");
+    report("canPlacePiece", grid_place, bit_place);
+    report("countCompleteLines", grid_lines, bit_lines);
+    report("isGameOver", grid_over, bit_over);
+    report("findDropPosition", stepped_drop, height_drop);
+    report("calculateStats/stats", full_stats, kept_stats);
+    return 0;
+}
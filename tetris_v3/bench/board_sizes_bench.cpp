@@ -0,0 +1,107 @@
+/**
+ * @file board_sizes_bench.cpp
+ * @brief Random play on boards of several compile-time sizes
+ *
+ * Instantiates BasicBoard for the standard field, a 16-column board (the
+ * widest that fits uint16_t rows), a 40-row field with a hidden buffer
+ * zone, and boards that need uint32_t and uint64_t rows. Each one plays
+ * greedy hard drops (random piece and rotation, lowest landing column)
+ * with line clears. Collision answers are checked against a cell-by-cell
+ * walk and the maintained statistics against a full recomputation; the
+ * rate counts pieces played, including the greedy column search.
+ */
+
+#include "Board.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+using namespace Tetris;
+
+namespace {
+
+template <typename BoardType>
+bool cellCanPlace(const BoardType& board, const Tetromino& piece, const Position& pos, Rotation rot) {
+    for (const auto& cell : Tetromino::geometry(piece.getType(), rot).cells) {
+        const Position p{pos.x + cell.x, pos.y + cell.y};
+        if (!board.isValidPosition(p) || board.getCell(p).occupied) return false;
+    }
+    return true;
+}
+
+struct SizeResult {
+    long pieces{0};
+    long lines{0};
+    long games{0};
+    long mismatches{0};
+    double seconds{0};
+};
+
+template <typename BoardType>
+SizeResult playRandom(uint32_t seed, long pieces) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> type_dist(0, 6);
+    std::uniform_int_distribution<int> rot_dist(0, 3);
+    std::uniform_int_distribution<int> probe_x(-3, BoardType::WIDTH);
+    std::uniform_int_distribution<int> probe_y(-3, BoardType::HEIGHT);
+
+    SizeResult result;
+    BoardType board;
+    const auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < pieces; ++i) {
+        Tetromino piece(static_cast<TetrominoType>(type_dist(rng)), {BoardType::SPAWN_X, BoardType::SPAWN_Y});
+        for (int r = rot_dist(rng); r > 0; --r) piece.rotateClockwise();
+
+        // Spot-check collision on a random probe every piece
+        const Position probe{probe_x(rng), probe_y(rng)};
+        result.mismatches += board.canPlacePiece(piece, probe, piece.getRotation()) !=
+                             cellCanPlace(board, piece, probe, piece.getRotation());
+
+        if (!board.canPlacePiece(piece)) {
+            board.reset();
+            result.games++;
+            continue;
+        }
+        // Land in whichever column lets the piece fall furthest
+        Position best = board.findDropPosition(piece);
+        for (int x = -2; x < BoardType::WIDTH; ++x) {
+            const Tetromino shifted = piece.withPosition({x, BoardType::SPAWN_Y});
+            if (!board.canPlacePiece(shifted)) continue;
+            const Position landing = board.findDropPosition(shifted);
+            if (landing.y > best.y) best = landing;
+        }
+        piece.setPosition(best);
+        board.placePiece(piece);
+        result.lines += board.clearLines();
+        result.pieces++;
+        if ((i & 63) == 0) result.mismatches += !board.verifyStats();
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+template <int Width, int Height>
+bool report(const char* name, long pieces) {
+    using BoardType = BasicBoard<Width, Height>;
+    const SizeResult r = playRandom<BoardType>(99, pieces);
+    std::printf("%-22s %2dx%-2d %-8s %8.2f M pieces/s   %7ld lines   %5ld games   %s\n",
+                name, Width, Height,
+                sizeof(typename BoardType::RowMask) == 2 ? "uint16" :
+                sizeof(typename BoardType::RowMask) == 4 ? "uint32" : "uint64",
+                static_cast<double>(r.pieces) / r.seconds / 1e6, r.lines, r.games,
+                r.mismatches == 0 ? "ok" : "MISMATCH");
+    return r.mismatches == 0;
+}
+
+} // namespace
+
+int main() {
+    const long pieces = 500000;
+    bool ok = true;
+    ok &= report<10, 20>("standard", pieces);
+    ok &= report<16, 20>("wide", pieces);
+    ok &= report<10, 40>("buffer zone", pieces);
+    ok &= report<24, 30>("uint32 rows", pieces);
+    ok &= report<48, 64>("uint64 rows", pieces);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,199 @@
+/**
+ * @file evaluator_bench.cpp
+ * @brief Evaluator feature correctness, weight files and throughput
+ *
+ * Every feature extracted from the row masks is compared with a plain
+ * cell-by-cell scan of getCell() on boards from random play. Weights must
+ * survive a write/parse round trip exactly, and malformed weight files must
+ * be rejected. Throughput is measured for feature extraction plus scoring
+ * on a pool of boards, and for whole placements (applyPiece, evaluate,
+ * undo). Finally a greedy one-piece bot (MoveGenerator + default weights)
+ * plays capped games on fixed seeds and reports lines cleared.
+ */
+
+#include "Evaluator.h"
+#include "MoveGenerator.h"
+#include "Random.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace Tetris;
+
+namespace {
+
+bool filled(const Board& board, int x, int y) {
+    if (x < 0 || x >= Board::WIDTH || y >= Board::HEIGHT) return true; // Walls and floor
+    if (y < 0) return false;
+    return board.getCell(x, y).occupied;
+}
+
+// The same features from one cell at a time
+BoardFeatures naiveFeatures(const Board& board, int lines_cleared) {
+    BoardFeatures f;
+    std::array<int, Board::WIDTH> heights{};
+    for (int x = 0; x < Board::WIDTH; ++x) {
+        for (int y = 0; y < Board::HEIGHT; ++y) {
+            if (filled(board, x, y)) {
+                heights[x] = Board::HEIGHT - y;
+                break;
+            }
+        }
+        f[Feature::TOTAL_HEIGHT] += heights[x];
+        f[Feature::MAX_HEIGHT] = std::max(f[Feature::MAX_HEIGHT], heights[x]);
+        if (x > 0) f[Feature::BUMPINESS] += std::abs(heights[x] - heights[x - 1]);
+
+        int lowest_hole = -1;
+        for (int y = Board::HEIGHT - heights[x]; y < Board::HEIGHT; ++y) {
+            if (!filled(board, x, y)) {
+                f[Feature::HOLES]++;
+                lowest_hole = y;
+            }
+        }
+        for (int y = Board::HEIGHT - heights[x]; y < lowest_hole; ++y) {
+            if (filled(board, x, y)) f[Feature::COVERED_CELLS]++;
+        }
+        for (int y = -1; y < Board::HEIGHT; ++y) {
+            if (filled(board, x, y) != filled(board, x, y + 1)) f[Feature::COLUMN_TRANSITIONS]++;
+        }
+    }
+    for (int x = 0; x < Board::WIDTH; ++x) {
+        const int left = x > 0 ? heights[x - 1] : Board::HEIGHT;
+        const int right = x < Board::WIDTH - 1 ? heights[x + 1] : Board::HEIGHT;
+        for (int depth = 1; depth <= std::min(left, right) - heights[x]; ++depth) f[Feature::WELLS] += depth;
+    }
+    for (int y = 0; y < Board::HEIGHT; ++y) {
+        bool full = true;
+        bool hole = false;
+        for (int x = -1; x < Board::WIDTH; ++x) {
+            if (filled(board, x, y) != filled(board, x + 1, y)) f[Feature::ROW_TRANSITIONS]++;
+            if (x >= 0) {
+                full &= filled(board, x, y);
+                hole |= !filled(board, x, y) && Board::HEIGHT - y < heights[x];
+            }
+        }
+        f[Feature::LINES_CLEARED] += full;
+        f[Feature::HOLE_ROWS] += hole;
+    }
+    f[Feature::LINES_CLEARED] += lines_cleared;
+    return f;
+}
+
+Tetromino spawn(Pcg32& rng) {
+    return createRandomTetromino(rng, {Board::SPAWN_X, Board::SPAWN_Y});
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    auto gen = std::make_unique<MoveGenerator>();
+    Pcg32 rng(45);
+
+    // Boards from random play, some with uncleared full rows
+    std::vector<Board> boards;
+    while (boards.size() < 4000) {
+        Board board;
+        for (int move = 0; move < 60; ++move) {
+            if (gen->generate(board, spawn(rng)) == 0) break;
+            board.placePiece(gen->piece((*gen)[static_cast<int>(rng.bounded(static_cast<uint32_t>(gen->size())))]));
+            if (rng.bounded(4) != 0) board.clearLines();
+            boards.push_back(board);
+        }
+    }
+
+    bool features_match = true;
+    for (size_t i = 0; i < boards.size(); ++i) {
+        const int lines = static_cast<int>(i % 3);
+        features_match &= extractFeatures(boards[i], lines).values == naiveFeatures(boards[i], lines).values;
+    }
+    std::printf("features vs cell scan on %zu boards: %s\n", boards.size(), features_match ? "match" : "MISMATCH");
+    ok &= features_match;
+
+    // Weight files
+    Evaluator::Weights weights{};
+    for (int i = 0; i < FEATURE_COUNT; ++i) weights[i] = (static_cast<double>(rng.next()) - 2147483648.0) / 3e8;
+    std::stringstream file;
+    Evaluator::writeWeights(file, weights);
+    bool weights_ok = Evaluator::parseWeights(file) == weights;
+    std::istringstream partial("# comment\n  holes -2.5  # trailing\n\nwells 1e-3\n");
+    const Evaluator::Weights parsed = Evaluator::parseWeights(partial);
+    weights_ok &= parsed[static_cast<size_t>(Feature::HOLES)] == -2.5 && parsed[static_cast<size_t>(Feature::WELLS)] == 1e-3 &&
+                  parsed[static_cast<size_t>(Feature::TOTAL_HEIGHT)] == 0;
+    for (const char* bad : {"holes", "holes x", "holes 1 2", "height 1", "holes 1\nholes 2"}) {
+        std::istringstream in(bad);
+        try {
+            (void)Evaluator::parseWeights(in);
+            weights_ok = false;
+        } catch (const std::runtime_error&) {
+        }
+    }
+    std::printf("weight file round trip and error checks: %s\n", weights_ok ? "ok" : "FAILED");
+    ok &= weights_ok;
+
+    // Greedy games with the default weights; their positions are the realistic throughput pool
+    const Evaluator evaluator;
+    const int games = 8;
+    const int max_pieces = 10000;
+    std::vector<int> lines;
+    std::vector<Board> played;
+    long pieces = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int g = 0; g < games; ++g) {
+        Pcg32 pieces_rng(static_cast<uint64_t>(g));
+        Board board;
+        int cleared = 0;
+        int placed = 0;
+        for (; placed < max_pieces; ++placed) {
+            if (gen->generate(board, spawn(pieces_rng)) == 0) break;
+            board.placePiece(gen->piece((*gen)[bestPlacement(board, *gen, evaluator)]));
+            cleared += board.clearLines();
+            if (board.isGameOver()) break;
+            if (placed % 16 == 0) played.push_back(board);
+        }
+        lines.push_back(cleared);
+        pieces += placed;
+    }
+    const double games_s = secondsSince(start);
+    std::sort(lines.begin(), lines.end());
+    std::printf("greedy default weights, %d games capped at %d pieces: lines min %d median %d max %d (%.0f pieces/s)\n",
+                games, max_pieces, lines.front(), lines[games / 2], lines.back(), static_cast<double>(pieces) / games_s);
+
+    // Throughput
+    volatile double sink = 0;
+    for (const auto* pool : {&played, &boards}) {
+        const long evaluations = 20000000;
+        double total = 0;
+        start = std::chrono::steady_clock::now();
+        for (long done = 0; done < evaluations; done += static_cast<long>(pool->size())) {
+            for (const auto& board : *pool) total += evaluator.evaluate(board, 1);
+        }
+        sink = sink + total;
+        const double eval_s = secondsSince(start);
+        std::printf("evaluate (%s, %zu boards): %.1f M boards/s (%.1f ns each)\n",
+                    pool == &played ? "greedy play" : "random play", pool->size(),
+                    evaluations / eval_s / 1e6, eval_s * 1e9 / evaluations);
+    }
+
+    uint64_t placements = 0;
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < played.size(); ++i) {
+        Board& board = played[i];
+        if (gen->generate(board, createTetromino(static_cast<TetrominoType>(i % PIECE_TYPE_COUNT),
+                                                 {Board::SPAWN_X, Board::SPAWN_Y})) == 0) continue;
+        sink = sink + bestPlacement(board, *gen, evaluator);
+        placements += static_cast<uint64_t>(gen->size());
+    }
+    const double place_s = secondsSince(start);
+    std::printf("move generation + apply/evaluate/undo: %.2f M placements/s\n", static_cast<double>(placements) / place_s / 1e6);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file hash_bench.cpp
+ * @brief Board hash consistency and collision rate on a random corpus
+ *
+ * Plays random games (random piece, rotation and column, hard drop, line
+ * clears) and records the board after every placement. The incremental
+ * hash must equal a full recomputation at every step. Distinct positions
+ * are identified by an independent FNV-1a key over the row masks; the
+ * observed collisions among them are then counted for the full 64-bit
+ * hash and for its low 40, 32 and 24 bits, next to the count a uniform
+ * random hash would give (n(n-1)/2 / 2^bits).
+ */
+
+#include "Board.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace Tetris;
+
+namespace {
+
+uint64_t fnv1a(const Board::RowMaskArray& rows) {
+    uint64_t key = 0xcbf29ce484222325ULL;
+    for (const auto row : rows) {
+        key ^= row & 0xff;
+        key *= 0x100000001b3ULL;
+        key ^= row >> 8;
+        key *= 0x100000001b3ULL;
+    }
+    return key;
+}
+
+// (hash, identity key) of every board reached, plus the number of hash mismatches
+std::pair<std::vector<std::pair<uint64_t, uint64_t>>, long> collectPositions(uint32_t seed, long placements) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> type_dist(0, 6);
+    std::uniform_int_distribution<int> x_dist(-1, Board::WIDTH - 2);
+    std::uniform_int_distribution<int> rot_dist(0, 3);
+
+    std::vector<std::pair<uint64_t, uint64_t>> positions;
+    positions.reserve(static_cast<size_t>(placements));
+    long mismatches = 0;
+    Board board;
+    int misses = 0;
+    while (static_cast<long>(positions.size()) < placements) {
+        Tetromino piece(static_cast<TetrominoType>(type_dist(rng)), {x_dist(rng), 0});
+        for (int r = rot_dist(rng); r > 0; --r) piece.rotateClockwise();
+        if (!board.canPlacePiece(piece)) {
+            // Topped out once pieces stop fitting anywhere
+            if (++misses == 16) {
+                board.reset();
+                misses = 0;
+            }
+            continue;
+        }
+        misses = 0;
+        piece.setPosition(board.findDropPosition(piece));
+        board.placePiece(piece);
+        board.clearLines();
+        mismatches += board.hash() != board.computeHash();
+        positions.emplace_back(board.hash(), fnv1a(board.getRowMasks()));
+    }
+    return {std::move(positions), mismatches};
+}
+
+// Pairs of distinct positions whose hashes agree in the low `bits` bits
+long countCollisions(const std::vector<uint64_t>& hashes, int bits) {
+    const uint64_t mask = bits == 64 ? ~uint64_t{0} : (uint64_t{1} << bits) - 1;
+    std::vector<uint64_t> truncated;
+    truncated.reserve(hashes.size());
+    for (const auto hash : hashes) truncated.push_back(hash & mask);
+    std::sort(truncated.begin(), truncated.end());
+    long pairs = 0;
+    for (size_t i = 0; i < truncated.size();) {
+        size_t j = i + 1;
+        while (j < truncated.size() && truncated[j] == truncated[i]) ++j;
+        const long run = static_cast<long>(j - i);
+        pairs += run * (run - 1) / 2;
+        i = j;
+    }
+    return pairs;
+}
+
+} // namespace
+
+int main() {
+    const long placements = 8000000;
+    auto [positions, mismatches] = collectPositions(2718, placements);
+    if (mismatches != 0) {
+        std::printf("incremental hash diverged from recomputation on %ld boards\n", mismatches);
+        return 1;
+    }
+
+    // Keep one entry per distinct position
+    std::sort(positions.begin(), positions.end(),
+              [](const auto& a, const auto& b) { return a.second < b.second; });
+    positions.erase(std::unique(positions.begin(), positions.end(),
+                                [](const auto& a, const auto& b) { return a.second == b.second; }),
+                    positions.end());
+    std::vector<uint64_t> hashes;
+    hashes.reserve(positions.size());
+    for (const auto& position : positions) hashes.push_back(position.first);
+
+    const double n = static_cast<double>(hashes.size());
+    std::printf("%ld placements, %zu distinct positions, incremental hash matches recomputation\n",
+                placements, hashes.size());
+    for (const int bits : {64, 40, 32, 24}) {
+        const double expected = std::ldexp(n * (n - 1) / 2, -bits);
+        std::printf("low %2d bits: %10ld colliding pairs   expected for a random hash %12.1f\n",
+                    bits, countCollisions(hashes, bits), expected);
+    }
+
+    // Reading the kept hash vs hashing the board from scratch
+    Board board;
+    for (int x = 0; x + 1 < Board::WIDTH; x += 2) {
+        Tetromino piece(TetrominoType::O, {x - 1, 0});
+        piece.setPosition(board.findDropPosition(piece));
+        board.placePiece(piece);
+    }
+    const int rounds = 20000000;
+    volatile uint64_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) sink = sink + board.computeHash();
+    const double full_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / rounds;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) sink = sink + board.hash();
+    const double kept_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / rounds;
+    std::printf("computeHash %6.2f ns   hash() %6.2f ns\n", full_ns, kept_ns);
+    return 0;
+}
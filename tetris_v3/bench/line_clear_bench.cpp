@@ -0,0 +1,222 @@
+/**
+ * @file line_clear_bench.cpp
+ * @brief Row-compaction line clear vs the previous per-line removal
+ *
+ * The reference reimplements the old clearLines: for every full row, shift
+ * every row above it down by one (grid and bitboard), then rescan the
+ * column heights and rebuild the statistics exactly as the board does.
+ * Random boards are built by hard-dropping pieces without clearing and by
+ * locking pieces at arbitrary valid positions, so they carry any mix of
+ * stacked full rows, gaps and floating blocks. Every board is cleared both
+ * ways and the grids, row masks, column heights and statistics must match
+ * before the two are timed on drop-only stacks. Boards are restored from
+ * copies between timed batches, outside the timed region.
+ */
+
+#include "Board.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace Tetris;
+
+namespace {
+
+// --- Reference: the original removeLine loop ---
+
+struct ReferenceBoard {
+    Board::GridType grid;
+    Board::RowMaskArray rows;
+    Board::HeightArray heights;
+    Board::BoardStats stats;
+    int filled_cells;
+    long row_copies{0};
+
+    explicit ReferenceBoard(const Board& board)
+        : grid(board.getGrid()), rows(board.getRowMasks()), heights(board.getColumnHeights()),
+          stats(board.stats()), filled_cells(0) {
+        for (const auto row : rows) filled_cells += popCount(row);
+    }
+};
+
+void referenceRemoveLine(ReferenceBoard& board, int line) {
+    board.row_copies += line;
+    for (int y = line; y > 0; --y) {
+        board.grid[y] = board.grid[y - 1];
+        board.rows[y] = board.rows[y - 1];
+    }
+    board.grid[0].fill(Cell());
+    board.rows[0] = 0;
+}
+
+int referenceClearLines(ReferenceBoard& board) {
+    int cleared_lines = 0;
+    for (int y = Board::HEIGHT - 1; y >= 0; --y) {
+        if (board.rows[y] == Board::FULL_ROW) {
+            referenceRemoveLine(board, y);
+            cleared_lines++;
+            y++; // Re-check the same line index as it's now new content
+        }
+    }
+    if (cleared_lines > 0) {
+        // Same height scan and statistics rebuild the board runs after a clear
+        board.filled_cells -= cleared_lines * Board::WIDTH;
+        board.heights.fill(0);
+        uint32_t seen = 0;
+        for (int y = 0; y < Board::HEIGHT && seen != Board::FULL_ROW; ++y) {
+            for (uint32_t fresh = board.rows[y] & ~seen; fresh != 0; fresh &= fresh - 1) {
+                board.heights[countTrailingZeros(fresh)] = Board::HEIGHT - y;
+            }
+            seen |= board.rows[y];
+        }
+        board.stats = Board::BoardStats{};
+        for (int x = 0; x < Board::WIDTH; ++x) {
+            board.stats.total_height += board.heights[x];
+            board.stats.max_height = std::max(board.stats.max_height, board.heights[x]);
+            if (x > 0) {
+                board.stats.bumpiness += std::abs(board.heights[x - 1] - board.heights[x]);
+            }
+        }
+        board.stats.holes = board.stats.total_height - board.filled_cells;
+        for (const auto row : board.rows) {
+            board.stats.complete_lines += row == Board::FULL_ROW;
+        }
+    }
+    return cleared_lines;
+}
+
+// Rows the compacting clear copies: every row from the lowest full row up to the top of the stack
+int compactedRowCopies(const Board& board) {
+    for (int y = Board::HEIGHT - 1; y >= 0; --y) {
+        if (board.isLineComplete(y)) return y - (Board::HEIGHT - board.stats().max_height);
+    }
+    return 0;
+}
+
+int gridColumnHeight(const Board::GridType& grid, int column) {
+    for (int y = 0; y < Board::HEIGHT; ++y) {
+        if (grid[y][column].occupied) return Board::HEIGHT - y;
+    }
+    return 0;
+}
+
+bool sameCells(const Board::GridType& a, const Board::GridType& b) {
+    for (int y = 0; y < Board::HEIGHT; ++y) {
+        for (int x = 0; x < Board::WIDTH; ++x) {
+            if (a[y][x].occupied != b[y][x].occupied || a[y][x].color != b[y][x].color) return false;
+        }
+    }
+    return true;
+}
+
+// --- Workload ---
+
+Board makeBoard(std::mt19937& rng, int attempts, bool mid_air) {
+    std::uniform_int_distribution<int> type_dist(0, 6);
+    std::uniform_int_distribution<int> x_dist(-2, Board::WIDTH);
+    std::uniform_int_distribution<int> y_dist(-2, Board::HEIGHT);
+    std::uniform_int_distribution<int> rot_dist(0, 3);
+    std::uniform_int_distribution<int> drop_dist(0, 3);
+    Board board;
+    for (int i = 0; i < attempts; ++i) {
+        Tetromino piece(static_cast<TetrominoType>(type_dist(rng)), {x_dist(rng), y_dist(rng)});
+        for (int r = rot_dist(rng); r > 0; --r) piece.rotateClockwise();
+        if (!mid_air || drop_dist(rng) != 0) {
+            // Mostly hard drops, which pack rows full; the rest lock in mid-air
+            piece.setPosition({piece.getPosition().x, 0});
+            if (!board.canPlacePiece(piece)) continue;
+            piece.setPosition(board.findDropPosition(piece));
+        }
+        board.placePiece(piece); // Rejected when it collides or leaves the board
+    }
+    return board;
+}
+
+// Restore a batch of boards untimed, then time clearing all of them
+template <typename BoardType, typename Fn>
+double nanosPerClear(const std::vector<BoardType>& sources, int rounds, Fn&& clear) {
+    std::vector<BoardType> work = sources;
+    std::chrono::steady_clock::duration elapsed{};
+    for (int r = 0; r < rounds; ++r) {
+        std::copy(sources.begin(), sources.end(), work.begin());
+        const auto start = std::chrono::steady_clock::now();
+        for (auto& board : work) clear(board);
+        elapsed += std::chrono::steady_clock::now() - start;
+    }
+    const double ops = static_cast<double>(rounds) * static_cast<double>(sources.size());
+    return std::chrono::duration<double, std::nano>(elapsed).count() / ops;
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(4242);
+
+    // Correctness: many random boards of every density
+    const int checked_boards = 200000;
+    long mismatches = 0;
+    long total_cleared = 0;
+    for (int i = 0; i < checked_boards; ++i) {
+        Board board = makeBoard(rng, 10 + i % 120, true);
+        ReferenceBoard reference(board);
+
+        const int cleared = board.clearLines();
+        const int expected = referenceClearLines(reference);
+        total_cleared += cleared;
+
+        bool same = cleared == expected && sameCells(board.getGrid(), reference.grid) &&
+                    board.getRowMasks() == reference.rows && board.verifyStats();
+        for (int x = 0; x < Board::WIDTH; ++x) {
+            same &= board.getColumnHeight(x) == gridColumnHeight(reference.grid, x);
+            same &= reference.heights[x] == board.getColumnHeight(x);
+        }
+        same &= reference.stats == board.stats();
+        mismatches += !same;
+    }
+    if (mismatches != 0) {
+        std::printf("row compaction and per-line removal disagree on %ld of %d boards\n", mismatches, checked_boards);
+        return 1;
+    }
+    std::printf("%d random boards, %ld lines cleared, results identical\n", checked_boards, total_cleared);
+
+    // Timing: stacks built by hard drops only, as in play, grouped by how many lines
+    // they clear (0 = the call after every lock that clears nothing)
+    const int rounds = 2000;
+    volatile long sink = 0;
+    for (int lines_per_clear = 0; lines_per_clear <= 4; ++lines_per_clear) {
+        std::vector<Board> boards;
+        for (int attempt = 0; boards.size() < 256 && attempt < 20000; ++attempt) {
+            Board board = makeBoard(rng, 5 + attempt % 40, false);
+            if (board.countCompleteLines() == lines_per_clear) boards.push_back(board);
+        }
+        if (boards.empty()) continue;
+        std::vector<ReferenceBoard> references;
+        long before_copies = 0;
+        long after_copies = 0;
+        for (const auto& board : boards) {
+            references.emplace_back(board);
+            ReferenceBoard cleared = references.back();
+            referenceClearLines(cleared);
+            before_copies += cleared.row_copies;
+            after_copies += compactedRowCopies(board);
+        }
+
+        long lines = 0;
+        const double per_line = nanosPerClear(references, rounds, [&](ReferenceBoard& board) {
+            lines += referenceClearLines(board);
+        });
+        const double compacted = nanosPerClear(boards, rounds, [&](Board& board) {
+            lines += board.clearLines();
+        });
+        sink = sink + lines;
+
+        const double count = static_cast<double>(boards.size());
+        std::printf("%d line%s  before %8.1f ns/op   after %8.1f ns/op   speedup %5.1fx   rows copied %5.1f -> %5.1f\n",
+                    lines_per_clear, lines_per_clear == 1 ? " " : "s", per_line, compacted, per_line / compacted,
+                    static_cast<double>(before_copies) / count, static_cast<double>(after_copies) / count);
+    }
+    return 0;
+}
@@ -0,0 +1,178 @@
+/**
+ * @file mcts_bench.cpp
+ * @brief MCTS rollout throughput by thread count, and strength against beam search at equal budgets
+ *
+ * Rollout throughput: MctsSearch runs on positions taken from beam-search
+ * games, with a fixed time per search, on 1, 2 and 4 threads sharing one
+ * tree; reported are rollouts per second and tree nodes per search. Two
+ * single-threaded searches with the same rollout limit must choose the
+ * same move (the search is deterministic without a clock).
+ *
+ * Strength: the AutoPlayer plays the same fixed-seed games headless (one
+ * nextAction() per tick) with the beam search and with MCTS, both given
+ * the same move budget per piece. Gravity is fixed at one row every three
+ * ticks, so pieces fall while the player walks them over and every game
+ * is played to the top-out (a cap far above any game seen only guards the
+ * run time). Reported are pieces survived and lines cleared (min, median,
+ * max), games topped out, mean stack height and the planning time
+ * actually used against the budget. The beam search looks only at the
+ * known pieces, so it finishes early however wide it is; it is run at the
+ * default width and at a width past which the games stop changing.
+ */
+
+#include "AutoPlayer.h"
+#include "MctsSearch.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace Tetris;
+
+namespace {
+
+struct Strength {
+    std::vector<int> lines;
+    std::vector<int> survived;          // Pieces placed per game
+    int topped_out{0};
+    long pieces{0};
+    long height_sum{0};                 // Stack height after each piece
+    double think_seconds{0};
+    uint64_t rollouts{0};
+};
+
+// One row every three ticks from the first piece on, with no level speed-up
+GameSimulation::Config fastGravity() {
+    GameSimulation::Config rules;
+    rules.difficulty.initial_drop_speed = 3 * GameSimulation::TICK_DURATION;
+    rules.difficulty.min_drop_speed = rules.difficulty.initial_drop_speed;
+    return rules;
+}
+
+Strength playGames(const AutoPlayer::Config& config, int games, int max_pieces) {
+    Strength strength;
+    AutoPlayer player(config);
+    GameSimulation sim(fastGravity());
+    for (int g = 0; g < games; ++g) {
+        sim.newGame(static_cast<uint64_t>(g) + 100);
+        player.reset();
+        int pieces = sim.getCounters().total_pieces;
+        while (!sim.isGameOver() && sim.getCounters().total_pieces <= max_pieces) {
+            const auto before = std::chrono::steady_clock::now();
+            const InputAction action = player.nextAction(sim);
+            strength.think_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - before).count();
+            sim.step(action);
+            if (sim.getCounters().total_pieces != pieces) {
+                pieces = sim.getCounters().total_pieces;
+                strength.height_sum += sim.getBoard().stats().max_height;
+            }
+        }
+        strength.lines.push_back(sim.getLinesCleared());
+        strength.survived.push_back(sim.getCounters().total_pieces);
+        strength.topped_out += sim.isGameOver();
+        strength.pieces += sim.getCounters().total_pieces;
+    }
+    strength.rollouts = player.getStats().rollouts;
+    std::sort(strength.lines.begin(), strength.lines.end());
+    std::sort(strength.survived.begin(), strength.survived.end());
+    return strength;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+
+    // Positions from a beam-search game
+    std::vector<GameSimulation> positions;
+    {
+        AutoPlayer player;
+        GameSimulation sim;
+        sim.newGame(48);
+        int last_pieces = 0;
+        while (!sim.isGameOver() && positions.size() < 16) {
+            sim.step(player.nextAction(sim));
+            if (sim.getCounters().total_pieces != last_pieces) {
+                last_pieces = sim.getCounters().total_pieces;
+                if (last_pieces % 10 == 0) positions.push_back(sim);
+            }
+        }
+    }
+
+    const Evaluator evaluator;
+    const auto per_search = std::chrono::milliseconds(50);
+    for (int threads : {1, 2, 4}) {
+        ThreadPool pool(threads);
+        MctsSearch search(MctsSearch::Config{}, evaluator, pool);
+        uint64_t rollouts = 0;
+        long nodes = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (const auto& position : positions) {
+            const auto result = search.search(position, std::chrono::steady_clock::now() + per_search);
+            rollouts += result.rollouts;
+            nodes += result.nodes;
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::printf("MCTS %d thread%s: %.0f rollouts/s, %.0f nodes per %lld ms search\n", threads,
+                    threads > 1 ? "s " : "  ", static_cast<double>(rollouts) / seconds,
+                    static_cast<double>(nodes) / static_cast<double>(positions.size()),
+                    static_cast<long long>(per_search.count()));
+    }
+
+    {
+        ThreadPool pool(1);
+        MctsSearch::Config config;
+        config.max_rollouts = 1500;
+        MctsSearch first(config, evaluator, pool);
+        MctsSearch second(config, evaluator, pool);
+        const auto far = std::chrono::steady_clock::now() + std::chrono::hours(1);
+        bool same = true;
+        for (const auto& position : positions) {
+            const auto a = first.search(position, far);
+            const auto b = second.search(position, far);
+            same &= a.piece == b.piece && a.position == b.position && a.rotation == b.rotation &&
+                    a.hold == b.hold && a.visits == b.visits && a.rollouts == config.max_rollouts;
+        }
+        std::printf("fixed rollout count (%llu) reproducible: %s\n",
+                    static_cast<unsigned long long>(config.max_rollouts), same ? "ok" : "FAILED");
+        ok &= same;
+    }
+
+    const int games = 10;
+    const int max_pieces = 5000;
+    struct Entry {
+        AutoPlayer::Search search;
+        int beam_width;
+        int budget_ms;
+    };
+    for (const Entry& entry : {Entry{AutoPlayer::Search::BEAM, 32, 5}, Entry{AutoPlayer::Search::BEAM, 256, 5},
+                               Entry{AutoPlayer::Search::MCTS, 32, 5}, Entry{AutoPlayer::Search::BEAM, 256, 20},
+                               Entry{AutoPlayer::Search::MCTS, 32, 20}}) {
+        AutoPlayer::Config config;
+        config.search = entry.search;
+        config.beam_width = entry.beam_width;
+        config.threads = 1;
+        config.move_budget = std::chrono::milliseconds(entry.budget_ms);
+        const Strength s = playGames(config, games, max_pieces);
+        const double think_ms = s.think_seconds * 1e3 / static_cast<double>(s.pieces);
+        char label[32];
+        if (entry.search == AutoPlayer::Search::BEAM) {
+            std::snprintf(label, sizeof(label), "beam %d", entry.beam_width);
+        } else {
+            std::snprintf(label, sizeof(label), "mcts");
+        }
+        std::printf("%-8s budget %2d ms: pieces min %4d median %4d max %4d, lines median %4d, %d/%d topped out, "
+                    "mean height %4.1f, %5.2f ms planning per piece (%3.0f%% of budget)",
+                    label, entry.budget_ms, s.survived.front(), s.survived[s.survived.size() / 2],
+                    s.survived.back(), s.lines[s.lines.size() / 2], s.topped_out, games,
+                    static_cast<double>(s.height_sum) / static_cast<double>(s.pieces), think_ms,
+                    100.0 * think_ms / entry.budget_ms);
+        if (entry.search == AutoPlayer::Search::MCTS) {
+            std::printf(", %.0f rollouts per piece", static_cast<double>(s.rollouts) / static_cast<double>(s.pieces));
+        }
+        std::printf("\n");
+    }
+
+    return ok ? 0 : 1;
+}
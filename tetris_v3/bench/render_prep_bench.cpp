@@ -0,0 +1,186 @@
+/**
+ * @file render_prep_bench.cpp
+ * @brief Per-frame render preparation cost: board copy vs overlay view
+ *
+ * "Before" reproduces the old getPreviewBoard path: copy the whole Board
+ * (grid, bitboard, stats and line-clear callback) and stamp the ghost piece
+ * into the copy. "After" builds a BoardOverlayView. Both are timed alone
+ * (prep) and followed by a read of every cell (full frame), the view's
+ * through forEachCell() as the renderer reads it. Both produce the same
+ * picture, and forEachCell() agrees with cellAt(), which is checked
+ * before timing.
+ */
+
+#include "BoardView.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace Tetris;
+
+namespace {
+
+struct Frame {
+    Board board;
+    Tetromino piece;
+};
+
+std::vector<Frame> makeFrames(std::mt19937& rng, int count) {
+    std::vector<Frame> frames;
+    std::uniform_int_distribution<int> type_dist(0, 6);
+    std::uniform_int_distribution<int> x_dist(-1, Board::WIDTH - 2);
+    std::uniform_int_distribution<int> rot_dist(0, 3);
+    int lines_seen = 0;
+    for (int i = 0; i < count; ++i) {
+        Frame frame;
+        // Renderer's board carries the game's line-clear callback
+        frame.board.setLineClearCallback([&lines_seen](int lines, int) { lines_seen += lines; });
+        for (int p = 0; p < 5 + i % 30; ++p) {
+            Tetromino piece(static_cast<TetrominoType>(type_dist(rng)), {x_dist(rng), 0});
+            for (int r = rot_dist(rng); r > 0; --r) piece.rotateClockwise();
+            if (!frame.board.canPlacePiece(piece)) continue;
+            piece.setPosition(frame.board.findDropPosition(piece));
+            frame.board.placePiece(piece);
+            frame.board.clearLines();
+        }
+        frame.piece = Tetromino(static_cast<TetrominoType>(type_dist(rng)), {Board::SPAWN_X, Board::SPAWN_Y});
+        if (!frame.board.canPlacePiece(frame.piece)) frame.piece.reset();
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+// Old path: copy the board and lock a ghost piece into the copy
+Board previewBoard(const Board& board, const Tetromino& piece) {
+    Board preview = board;
+    if (piece.isValid()) {
+        preview.placePiece(piece.withPosition(board.findDropPosition(piece)));
+    }
+    return preview;
+}
+
+// Reduce a frame's picture to a checksum the way the renderer walks it
+uint32_t copySignature(const Board& board, const Tetromino& piece) {
+    const Board preview = previewBoard(board, piece);
+    const auto& grid = preview.getGrid();
+    uint32_t sum = 0;
+    for (int y = 0; y < Board::HEIGHT; ++y) {
+        for (int x = 0; x < Board::WIDTH; ++x) {
+            // What renderCell read from the preview: occupancy and color
+            sum = sum * 31 + grid[y][x].occupied * 4u + grid[y][x].color;
+        }
+    }
+    return sum;
+}
+
+uint32_t viewSignature(const Board& board, const Tetromino& piece) {
+    const BoardOverlayView view(board, piece, true);
+    uint32_t sum = 0;
+    for (int y = 0; y < Board::HEIGHT; ++y) {
+        view.forEachCell(y, [&sum](int, const ViewCell& cell) {
+            sum = sum * 31 + static_cast<uint32_t>(cell.layer) * 4u + cell.color;
+        });
+    }
+    return sum;
+}
+
+// The preview copy marks locked and ghost cells occupied; where the active
+// piece covers its own ghost the view reports ACTIVE, so resolve those cells
+// from the ghost position the view computed
+bool viewMatchesPreview(const Board& board, const Tetromino& piece) {
+    const BoardOverlayView view(board, piece, true);
+    const Board preview = previewBoard(board, piece);
+    for (int y = 0; y < Board::HEIGHT; ++y) {
+        for (int x = 0; x < Board::WIDTH; ++x) {
+            const CellLayer layer = view.cellAt(x, y).layer;
+            bool shown = layer == CellLayer::LOCKED || layer == CellLayer::GHOST;
+            if (layer == CellLayer::ACTIVE) {
+                for (const auto& cell : piece.getGeometry().cells) {
+                    shown |= view.getGhostPosition().x + cell.x == x && view.getGhostPosition().y + cell.y == y;
+                }
+            }
+            if (shown != preview.getGrid()[y][x].occupied) return false;
+        }
+    }
+    return true;
+}
+
+// The row walk must decode every cell the same way as single-cell queries
+bool rowWalkMatchesCells(const Board& board, const Tetromino& piece) {
+    const BoardOverlayView view(board, piece, true);
+    bool same = true;
+    for (int y = 0; y < Board::HEIGHT; ++y) {
+        view.forEachCell(y, [&](int x, const ViewCell& cell) {
+            const ViewCell single = view.cellAt(x, y);
+            same &= cell.layer == single.layer && cell.color == single.color;
+        });
+    }
+    return same;
+}
+
+template <typename Fn>
+double nanosPerFrame(long frames, Fn&& fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(frames);
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(777);
+    const auto frames = makeFrames(rng, 256);
+
+    for (const auto& frame : frames) {
+        if (!viewMatchesPreview(frame.board, frame.piece)) {
+            std::printf("overlay view and preview board disagree\n");
+            return 1;
+        }
+        if (!rowWalkMatchesCells(frame.board, frame.piece)) {
+            std::printf("forEachCell and cellAt disagree\n");
+            return 1;
+        }
+    }
+
+    const int rounds = 2000;
+    const long total = static_cast<long>(rounds) * static_cast<long>(frames.size());
+    volatile uint32_t sink = 0;
+
+    const double copy_prep = nanosPerFrame(total, [&] {
+        uint32_t sum = 0;
+        for (int r = 0; r < rounds; ++r)
+            for (const auto& frame : frames) sum += previewBoard(frame.board, frame.piece).getRowMasks()[Board::HEIGHT - 1];
+        sink = sink + sum;
+    });
+    const double view_prep = nanosPerFrame(total, [&] {
+        uint32_t sum = 0;
+        for (int r = 0; r < rounds; ++r)
+            for (const auto& frame : frames) sum += BoardOverlayView(frame.board, frame.piece, true).rowAt(Board::HEIGHT - 1).ghost;
+        sink = sink + sum;
+    });
+    const double copy_frame = nanosPerFrame(total, [&] {
+        uint32_t sum = 0;
+        for (int r = 0; r < rounds; ++r)
+            for (const auto& frame : frames) sum += copySignature(frame.board, frame.piece);
+        sink = sink + sum;
+    });
+    const double view_frame = nanosPerFrame(total, [&] {
+        uint32_t sum = 0;
+        for (int r = 0; r < rounds; ++r)
+            for (const auto& frame : frames) sum += viewSignature(frame.board, frame.piece);
+        sink = sink + sum;
+    });
+
+    std::printf("%zu frames, overlay identical to preview copy\n", frames.size());
+    std::printf("before = copy + stamp ghost, after = overlay view; full frame also reads all %d cells\n",
+                Board::WIDTH * Board::HEIGHT);
+    std::printf("%-12s before %8.1f ns/frame   after %8.1f ns/frame   speedup %5.1fx\n",
+                "prep", copy_prep, view_prep, copy_prep / view_prep);
+    std::printf("%-12s before %8.1f ns/frame   after %8.1f ns/frame   speedup %5.1fx\n",
+                "full frame", copy_frame, view_frame, copy_frame / view_frame);
+    std::printf("bytes copied per frame: before %zu, after 0 (view is %zu bytes)\n",
+                sizeof(Board), sizeof(BoardOverlayView));
+    return 0;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file replay_bench.cpp
+ * @brief Replay size, encoding speed and full-speed playback
+ *
+ * Records games played with random inputs (drawn from a per-game Pcg32,
+ * one chance per tick), keeping only the actions that changed the game,
+ * as TetrisGame does. Every recording must survive encode/decode unchanged
+ * and, replayed headless, end with the recorded score, lines, pieces and
+ * ticks. Reports bytes per event and per game, encode/decode time and
+ * playback speed in games and ticks per second.
+ */
+
+#include "Replay.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace Tetris;
+
+namespace {
+
+constexpr std::array<InputAction, 7> ACTIONS = {
+    InputAction::MOVE_LEFT, InputAction::MOVE_RIGHT, InputAction::ROTATE_CW, InputAction::ROTATE_CCW,
+    InputAction::SOFT_DROP, InputAction::HOLD, InputAction::HARD_DROP};
+
+Replay recordGame(GameSimulation& sim, uint64_t seed) {
+    sim.newGame(seed);
+    Replay replay(seed, sim.getConfig());
+    Pcg32 input(seed, 0x5eed);
+    while (!sim.isGameOver()) {
+        // Moves, rotations, soft drops and holds on about a third of the ticks, a rare hard drop
+        const uint32_t roll = input.bounded(32);
+        if (roll <= 12) {
+            const InputAction action = roll == 12 ? InputAction::HARD_DROP : ACTIONS[roll % 6];
+            const uint64_t tick = sim.getCounters().ticks;
+            if (sim.applyAction(action)) replay.record(tick, action);
+        }
+        sim.tick();
+    }
+    replay.finish(sim);
+    return replay;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main() {
+    const int games = 2000;
+    bool ok = true;
+
+    GameSimulation sim;
+    std::vector<Replay> replays;
+    replays.reserve(games);
+    auto start = std::chrono::steady_clock::now();
+    for (int g = 0; g < games; ++g) replays.push_back(recordGame(sim, static_cast<uint64_t>(g)));
+    const double record_s = secondsSince(start);
+
+    size_t events = 0;
+    uint64_t ticks = 0;
+    for (const auto& replay : replays) {
+        events += replay.getEvents().size();
+        ticks += replay.getResult().ticks;
+    }
+
+    std::vector<std::vector<uint8_t>> encoded;
+    encoded.reserve(games);
+    start = std::chrono::steady_clock::now();
+    for (const auto& replay : replays) encoded.push_back(replay.encode());
+    const double encode_s = secondsSince(start);
+
+    size_t bytes = 0;
+    for (const auto& data : encoded) bytes += data.size();
+
+    std::vector<Replay> decoded;
+    decoded.reserve(games);
+    start = std::chrono::steady_clock::now();
+    for (const auto& data : encoded) decoded.push_back(Replay::decode(data));
+    const double decode_s = secondsSince(start);
+
+    bool round_trip = true;
+    for (int g = 0; g < games; ++g) round_trip &= decoded[g] == replays[g];
+    std::printf("round trip: %s\n", round_trip ? "identical" : "MISMATCH");
+    ok &= round_trip;
+
+    // Truncated data must be rejected rather than misread
+    bool rejects_truncated = true;
+    for (size_t cut = 0; cut < encoded[0].size(); ++cut) {
+        try {
+            (void)Replay::decode(std::vector<uint8_t>(encoded[0].begin(), encoded[0].begin() + static_cast<long>(cut)));
+            rejects_truncated = false;
+        } catch (const std::runtime_error&) {
+        }
+    }
+    std::printf("truncated data rejected: %s\n", rejects_truncated ? "yes" : "NO");
+    ok &= rejects_truncated;
+
+    int matched = 0;
+    start = std::chrono::steady_clock::now();
+    for (const auto& replay : decoded) {
+        ReplayPlayer player(replay, sim);
+        player.runToEnd();
+        matched += player.matchesRecording() ? 1 : 0;
+    }
+    const double replay_s = secondsSince(start);
+    std::printf("replays matching their recording: %d / %d\n", matched, games);
+    ok &= matched == games;
+
+    std::printf("%d games, %zu events, %llu ticks (recorded in %.2f s)\n", games, events,
+                static_cast<unsigned long long>(ticks), record_s);
+    std::printf("size: %.1f bytes/game, %.2f bytes/event including header and result\n",
+                static_cast<double>(bytes) / games, static_cast<double>(bytes) / static_cast<double>(events));
+    std::printf("encode %.2f us/game, decode %.2f us/game\n", encode_s * 1e6 / games, decode_s * 1e6 / games);
+    std::printf("playback: %.0f games/s, %.2f M ticks/s (%.0fx real time)\n", games / replay_s,
+                static_cast<double>(ticks) / replay_s / 1e6,
+                static_cast<double>(ticks) * GameSimulation::TICK_DURATION.count() / 1000.0 / replay_s);
+
+    return ok ? 0 : 1;
+}
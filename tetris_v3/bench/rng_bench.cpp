@@ -0,0 +1,161 @@
+/**
+ * @file rng_bench.cpp
+ * @brief Pcg32 reproducibility and speed against std::mt19937
+ *
+ * Pcg32 seeded like the reference pcg32_srandom_r(42, 54) must produce the
+ * published first outputs. The opening pieces of GameSimulation games for
+ * seeds 0-9 (bag and non-bag) are pinned as strings, so any change to the
+ * seeding, the bounded draw or the shuffle shows up here, whichever
+ * compiler built it. Every aligned group of 7 bag pieces must be a
+ * permutation, and bounded(7) must pass a chi-square test. The timings
+ * compare raw 32-bit draws, bag refills and non-bag piece draws with
+ * std::mt19937 plus std::shuffle / std::uniform_int_distribution, the
+ * previous implementation.
+ */
+
+#include "GameSimulation.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+
+using namespace Tetris;
+
+namespace {
+
+constexpr char PIECE_LETTERS[] = "IOTSZJL";
+
+// First two pieces of games seeded 0..9 (current, next), as dealt by this implementation
+std::string openingPieces(bool bag) {
+    GameSimulation::Config config;
+    config.enable_7_bag = bag;
+    GameSimulation sim(config);
+    std::string pieces;
+    for (uint64_t seed = 0; seed < 10; ++seed) {
+        sim.newGame(seed);
+        pieces += PIECE_LETTERS[static_cast<int>(sim.getCurrentPiece().getType())];
+        pieces += PIECE_LETTERS[static_cast<int>(sim.getNextPiece().getType())];
+    }
+    return pieces;
+}
+
+// The bag sequence GameSimulation deals, drawn straight from the generator
+std::string bagSequence(uint64_t seed, int bags) {
+    Pcg32 rng(seed);
+    std::string pieces;
+    for (int b = 0; b < bags; ++b) {
+        std::array<char, PIECE_TYPE_COUNT> bag{'I', 'O', 'T', 'S', 'Z', 'J', 'L'};
+        rng.shuffle(bag);
+        pieces.append(bag.begin(), bag.end());
+    }
+    return pieces;
+}
+
+template <typename Fn>
+double nanosPer(long count, Fn&& fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+           static_cast<double>(count);
+}
+
+void reportTiming(const char* name, double before, double after) {
+    std::printf("%-14s mt19937 %6.2f ns   Pcg32 %6.2f ns   speedup %4.1fx\n", name, before, after, before / after);
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+
+    // Reference outputs of pcg32_srandom_r(&rng, 42u, 54u) from the PCG distribution
+    const std::array<uint32_t, 6> reference = {0xa15c02b7, 0x7b47f409, 0xba1d3330, 0x83d2f293, 0xbfa4784b, 0xcbed606e};
+    Pcg32 ref(42, 54);
+    for (const uint32_t expected : reference) ok &= ref.next() == expected;
+    std::printf("reference stream (42, 54): %s\n", ok ? "matches" : "MISMATCH");
+
+    const std::string bag_openings = openingPieces(true);
+    const std::string random_openings = openingPieces(false);
+    const std::string bag_run = bagSequence(1, 4);
+    const bool pinned = bag_openings == "IJSJOZJLSTZJSTSZISOI" &&
+                        random_openings == "SOTISTZOIJTTJOTTZLZS" &&
+                        bag_run == "SJLOZITSOIJTZLZSIOJLTTLZSJOI";
+    std::printf("pinned sequences: %s\n  bag openings    %s\n  random openings %s\n  seed 1 bags     %s\n",
+                pinned ? "match" : "MISMATCH", bag_openings.c_str(), random_openings.c_str(), bag_run.c_str());
+    ok &= pinned;
+
+    // Every aligned run of 7 bag pieces holds each piece once
+    bool permutations = true;
+    for (uint64_t seed = 0; seed < 1000; ++seed) {
+        const std::string run = bagSequence(seed, 8);
+        for (size_t b = 0; b < run.size(); b += PIECE_TYPE_COUNT) {
+            std::string bag = run.substr(b, PIECE_TYPE_COUNT);
+            std::sort(bag.begin(), bag.end());
+            permutations &= bag == "IJLOSTZ";
+        }
+    }
+    std::printf("bags are permutations: %s\n", permutations ? "yes" : "NO");
+    ok &= permutations;
+
+    // Chi-square of bounded(7) over 7M draws (6 degrees of freedom, 0.1% critical value 22.46)
+    Pcg32 rng(7);
+    std::array<long, PIECE_TYPE_COUNT> counts{};
+    const long draws = 7000000;
+    for (long i = 0; i < draws; ++i) counts[rng.bounded(PIECE_TYPE_COUNT)]++;
+    double chi_square = 0;
+    for (const long count : counts) {
+        const double diff = static_cast<double>(count) - draws / 7.0;
+        chi_square += diff * diff / (draws / 7.0);
+    }
+    std::printf("bounded(7) chi-square %.2f (< 22.46 expected)\n", chi_square);
+    ok &= chi_square < 22.46;
+
+    // Timings
+    const long n = 50000000;
+    volatile uint32_t sink = 0;
+    std::mt19937 mt(1);
+    Pcg32 pcg(1);
+    const double mt_raw = nanosPer(n, [&] {
+        uint32_t sum = 0;
+        for (long i = 0; i < n; ++i) sum += mt();
+        sink = sink + sum;
+    });
+    const double pcg_raw = nanosPer(n, [&] {
+        uint32_t sum = 0;
+        for (long i = 0; i < n; ++i) sum += pcg();
+        sink = sink + sum;
+    });
+    reportTiming("32-bit draw", mt_raw, pcg_raw);
+
+    const long bags = 5000000;
+    std::array<TetrominoType, PIECE_TYPE_COUNT> bag{
+        TetrominoType::I, TetrominoType::O, TetrominoType::T, TetrominoType::S,
+        TetrominoType::Z, TetrominoType::J, TetrominoType::L};
+    const double mt_bag = nanosPer(bags, [&] {
+        for (long i = 0; i < bags; ++i) std::shuffle(bag.begin(), bag.end(), mt);
+        sink = sink + static_cast<uint32_t>(bag[0]);
+    });
+    const double pcg_bag = nanosPer(bags, [&] {
+        for (long i = 0; i < bags; ++i) pcg.shuffle(bag);
+        sink = sink + static_cast<uint32_t>(bag[0]);
+    });
+    reportTiming("bag refill", mt_bag, pcg_bag);
+
+    std::uniform_int_distribution<int> type_dist(0, PIECE_TYPE_COUNT - 1);
+    const double mt_piece = nanosPer(n, [&] {
+        uint32_t sum = 0;
+        for (long i = 0; i < n; ++i) sum += static_cast<uint32_t>(type_dist(mt));
+        sink = sink + sum;
+    });
+    const double pcg_piece = nanosPer(n, [&] {
+        uint32_t sum = 0;
+        for (long i = 0; i < n; ++i) sum += pcg.bounded(PIECE_TYPE_COUNT);
+        sink = sink + sum;
+    });
+    reportTiming("random piece", mt_piece, pcg_piece);
+    std::printf("generator state: mt19937 %zu bytes, Pcg32 %zu bytes\n", sizeof(std::mt19937), sizeof(Pcg32));
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,218 @@
+/**
+ * @file tetris_bench.cpp
+ * @brief Batch game throughput across threads: the regression gate for engine changes
+ *
+ * Plays K whole games headless on GameSimulation (the Board, Tetromino,
+ * spawning and scoring rules TetrisGame runs, with no terminal, sleeps or
+ * frame clock) on T threads, one GameSimulation per worker. A scripted
+ * policy seeded per game sends one action per tick: for each new piece it
+ * usually picks the rotation and column where the piece lands lowest,
+ * sometimes a random legal one, sometimes holds first, and mostly hard
+ * drops but sometimes soft drops to the lock, so collision, kicks, line
+ * clears, holds, gravity, locking and spawning all stay on the measured
+ * path.
+ *
+ * The games are first played once on one thread to record their results.
+ * The timed run must reproduce every result on T threads; the results are
+ * also folded into a checksum that changes whenever an engine change
+ * changes how a game plays. The checksum must equal --expect, or with no
+ * --expect and the default games, seed and piece cap, the value pinned
+ * below; an intended change to how games play updates the pin in the same
+ * commit. Reported are games/s, pieces/s, p50/p99
+ * wall time per piece (from a piece's spawn to the next one's, policy
+ * included) and heap allocations per piece, which must be 0: the timing
+ * buffers are sized from the first run, so the timed run allocates nothing.
+ *
+ * Usage: tetris_bench [--games K] [--threads T] [--seed S] [--max-pieces N] [--expect HEX]
+ */
+
+#include "AllocationCounter.h"
+#include "BoardHash.h"
+#include "GameSimulation.h"
+#include "Replay.h"
+#include "ScriptedPolicy.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Tetris;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Results checksum of the default games, seed and piece cap
+constexpr uint64_t PINNED_CHECKSUM = 0xbc01dea4f01878d2ULL;
+
+struct Settings {
+    int games{20000};
+    int threads{0};                     // 0 = one per hardware thread
+    uint64_t seed{2025};
+    int max_pieces{1000};               // Games that survive longer are cut off here
+    std::optional<uint64_t> expect;     // Checksum the results must have
+
+    [[nodiscard]] bool isDefaultRun() const noexcept {
+        const Settings defaults;
+        return games == defaults.games && seed == defaults.seed && max_pieces == defaults.max_pieces;
+    }
+};
+
+// Mostly the lowest hard drop; 1 in 16 pieces a random spot, 1 in 16 a hold first, 1 in 8 a soft drop
+constexpr Bench::ScriptedPolicy::Odds POLICY_ODDS{16, 16, 8};
+
+/**
+ * @brief Play one game, writing the time of each piece into times
+ * @param times Room for one entry per piece spawned plus one, or null to skip timing
+ * @param time_count Set to the number of entries written
+ */
+ReplayResult playGame(GameSimulation& sim, uint64_t seed, int game, int max_pieces, uint32_t* times, int& time_count) {
+    Bench::ScriptedPolicy policy(POLICY_ODDS);
+    policy.newGame(seed, static_cast<uint64_t>(game));
+    sim.newGame(mix64(seed + static_cast<uint64_t>(game)));
+    time_count = 0;
+    int timed_piece = sim.getCounters().total_pieces;
+    auto piece_start = Clock::now();
+    while (!sim.isGameOver() && sim.getCounters().total_pieces <= max_pieces) {
+        if (times && sim.getCounters().total_pieces != timed_piece) {
+            const auto now = Clock::now();
+            times[time_count++] = static_cast<uint32_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(now - piece_start).count());
+            piece_start = now;
+            timed_piece = sim.getCounters().total_pieces;
+        }
+        sim.step(policy.nextAction(sim));
+    }
+    if (times) {
+        times[time_count++] = static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - piece_start).count());
+    }
+    return ReplayResult::of(sim);
+}
+
+uint64_t checksum(const std::vector<ReplayResult>& results) {
+    uint64_t hash = 0;
+    for (const ReplayResult& r : results) {
+        hash = mix64(hash ^ static_cast<uint64_t>(r.score));
+        hash = mix64(hash ^ static_cast<uint64_t>(r.lines_cleared) << 32 ^ static_cast<uint64_t>(r.total_pieces));
+        hash = mix64(hash ^ r.ticks);
+    }
+    return hash;
+}
+
+bool parseArgs(int argc, char* argv[], Settings& settings) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--games" && i + 1 < argc) {
+            settings.games = std::stoi(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            settings.threads = std::stoi(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            settings.seed = std::stoull(argv[++i]);
+        } else if (arg == "--max-pieces" && i + 1 < argc) {
+            settings.max_pieces = std::stoi(argv[++i]);
+        } else if (arg == "--expect" && i + 1 < argc) {
+            settings.expect = std::stoull(argv[++i], nullptr, 16);
+        } else {
+            return false;
+        }
+    }
+    return settings.games > 0 && settings.threads >= 0 && settings.max_pieces > 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Settings settings;
+    if (!parseArgs(argc, argv, settings)) {
+        std::fprintf(stderr, "Usage: %s [--games K] [--threads T] [--seed S] [--max-pieces N] [--expect HEX]\n", argv[0]);
+        return 1;
+    }
+
+    ThreadPool pool(settings.threads);
+    const int threads = pool.size();
+    std::printf("hardware threads: %u, %d games on %d thread%s, seed %llu, up to %d pieces per game\n",
+                std::thread::hardware_concurrency(), settings.games, threads, threads > 1 ? "s" : "",
+                static_cast<unsigned long long>(settings.seed), settings.max_pieces);
+
+    // Reference run: one thread, untimed
+    std::vector<ReplayResult> expected(static_cast<size_t>(settings.games));
+    {
+        GameSimulation sim;
+        int unused = 0;
+        for (int g = 0; g < settings.games; ++g) {
+            expected[g] = playGame(sim, settings.seed, g, settings.max_pieces, nullptr, unused);
+        }
+    }
+
+    // Each game writes its piece times into its own slice, sized from the reference run
+    std::vector<size_t> offsets(expected.size() + 1, 0);
+    for (size_t g = 0; g < expected.size(); ++g) {
+        offsets[g + 1] = offsets[g] + static_cast<size_t>(expected[g].total_pieces) + 1;
+    }
+    std::vector<uint32_t> times(offsets.back(), 0);
+    std::vector<int> time_counts(expected.size(), 0);
+    std::vector<ReplayResult> results(expected.size());
+    std::vector<GameSimulation> sims(static_cast<size_t>(threads));
+
+    // Built outside the timed run: a std::function this large may allocate
+    const std::function<void(int, int)> body = [&](int game, int worker) {
+        results[game] = playGame(sims[worker], settings.seed, game, settings.max_pieces, &times[offsets[game]],
+                                 time_counts[game]);
+    };
+
+    const uint64_t allocations_before = Bench::allocationCount();
+    const auto start = Clock::now();
+    pool.parallelFor(settings.games, body);
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    const uint64_t allocations = Bench::allocationCount() - allocations_before;
+
+    int mismatches = 0;
+    long pieces = 0;
+    long lines = 0;
+    for (size_t g = 0; g < expected.size(); ++g) {
+        mismatches += results[g] != expected[g];
+        pieces += results[g].total_pieces;
+        lines += results[g].lines_cleared;
+    }
+
+    // Gather the piece times (after the allocation count was taken)
+    std::vector<uint32_t> samples;
+    samples.reserve(times.size());
+    for (size_t g = 0; g < expected.size(); ++g) {
+        samples.insert(samples.end(), times.begin() + static_cast<std::ptrdiff_t>(offsets[g]),
+                       times.begin() + static_cast<std::ptrdiff_t>(offsets[g]) + time_counts[g]);
+    }
+    std::sort(samples.begin(), samples.end());
+    const auto percentile = [&samples](double q) {
+        return samples.empty() ? 0u : samples[static_cast<size_t>(q * static_cast<double>(samples.size() - 1))];
+    };
+
+    const double allocations_per_piece = static_cast<double>(allocations) / static_cast<double>(pieces);
+    std::printf("%.0f games/s, %.3f M pieces/s, per piece p50 %u ns p99 %u ns, %.3f allocations/piece\n",
+                settings.games / seconds, static_cast<double>(pieces) / seconds / 1e6, percentile(0.50),
+                percentile(0.99), allocations_per_piece);
+    const uint64_t sum = checksum(results);
+    std::printf("%.1f pieces/game, %.1f lines/game, results checksum %016llx, %s\n",
+                static_cast<double>(pieces) / settings.games, static_cast<double>(lines) / settings.games,
+                static_cast<unsigned long long>(sum),
+                mismatches == 0 ? "matches the single-thread run" : "DIFFERS FROM THE SINGLE-THREAD RUN");
+
+    bool checksum_ok = true;
+    if (settings.expect || settings.isDefaultRun()) {
+        const uint64_t expected_sum = settings.expect ? *settings.expect : PINNED_CHECKSUM;
+        checksum_ok = sum == expected_sum;
+        std::printf("expected checksum %016llx (%s): %s\n", static_cast<unsigned long long>(expected_sum),
+                    settings.expect ? "--expect" : "pinned", checksum_ok ? "ok" : "MISMATCH, games play differently");
+    }
+
+    if (allocations != 0) {
+        std::printf("FAILED: %llu allocations in the timed run\n", static_cast<unsigned long long>(allocations));
+    }
+    return mismatches == 0 && allocations == 0 && checksum_ok ? 0 : 1;
+}
@@ -0,0 +1,206 @@
+/**
+ * @file tt_bench.cpp
+ * @brief Transposition table correctness under concurrent writes, and hit rate by size
+ *
+ * First every thread hammers a deliberately small table with stores and
+ * probes of keys from a shared key space, each key always stored with the
+ * score and depth derived from it; any hit that does not match its key is
+ * a torn or misattributed slot and fails the run. Then a lookahead search
+ * (three plies over a seven-piece sequence, with hold, from boards of
+ * random play, maximising the evaluator) runs with and without the table
+ * for several table sizes, roots spread over a ThreadPool that shares one
+ * table. Hold lets two pieces go down in either order, which is where
+ * transpositions come from. Every root must get the same value as the
+ * table-free search; reported are hit rate, occupancy, evictions and
+ * search time.
+ */
+
+#include "Evaluator.h"
+#include "MoveGenerator.h"
+#include "ThreadPool.h"
+#include "TranspositionTable.h"
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using namespace Tetris;
+
+namespace {
+
+constexpr int DEPTH = 3;
+constexpr int SEQUENCE = 2 * DEPTH + 1;   // Holding can use up two pieces per ply
+
+struct Root {
+    Board board;
+    std::array<TetrominoType, SEQUENCE> pieces;
+};
+
+struct SearchContext {
+    std::array<std::unique_ptr<MoveGenerator>, DEPTH> generators;
+    TranspositionTable* table{nullptr};
+    const Evaluator* evaluator{nullptr};
+    const Root* root{nullptr};
+    uint64_t nodes{0};
+    TranspositionTable::Stats table_stats;
+};
+
+// The value of a position depends on the board, the pieces still to come, the held piece and the depth
+uint64_t positionKey(const Board& board, const Root& root, int index, TetrominoType hold, int depth) {
+    uint64_t rest = static_cast<uint64_t>(hold) | static_cast<uint64_t>(depth) << 4;
+    for (int i = index + 1; i < SEQUENCE; ++i) rest = rest << 3 | static_cast<uint64_t>(root.pieces[i]);
+    return TranspositionTable::key(board, root.pieces[index]) ^ mix64(rest);
+}
+
+double search(Board& board, int index, TetrominoType hold, int depth, SearchContext& ctx);
+
+// Best value over the placements of one piece
+double placeAll(Board& board, TetrominoType type, int index, TetrominoType hold, int depth, SearchContext& ctx) {
+    MoveGenerator& gen = *ctx.generators[DEPTH - depth];
+    if (gen.generate(board, createTetromino(type, {Board::SPAWN_X, Board::SPAWN_Y})) == 0) return -1e9;
+    double best = -1e9;
+    Board::UndoRecord record;
+    for (const Placement& placement : gen) {
+        board.applyPiece(gen.piece(placement), record);
+        ctx.nodes++;
+        const double value = depth == 1 ? ctx.evaluator->evaluate(board) : search(board, index, hold, depth - 1, ctx);
+        board.undo(record);
+        best = std::max(best, value);
+    }
+    return best;
+}
+
+double search(Board& board, int index, TetrominoType hold, int depth, SearchContext& ctx) {
+    const uint64_t key = positionKey(board, *ctx.root, index, hold, depth);
+    TranspositionTable::Entry entry;
+    if (ctx.table && ctx.table->probe(key, entry, ctx.table_stats) && entry.depth >= depth) return entry.score;
+
+    const auto& pieces = ctx.root->pieces;
+    double best = placeAll(board, pieces[index], index + 1, hold, depth, ctx);
+    if (hold != TetrominoType::NONE && hold != pieces[index]) {
+        best = std::max(best, placeAll(board, hold, index + 1, pieces[index], depth, ctx));
+    } else if (hold == TetrominoType::NONE && pieces[index + 1] != pieces[index]) {
+        best = std::max(best, placeAll(board, pieces[index + 1], index + 2, pieces[index], depth, ctx));
+    }
+
+    if (ctx.table) ctx.table->store(key, best, depth, ctx.table_stats);
+    return best;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    ThreadPool pool(4);
+
+    // Concurrent stores and probes on a small table: every hit must carry its own key's data
+    {
+        TranspositionTable table(1);
+        const int per_thread = 2000000;
+        const uint64_t key_space = table.capacity() * 4;
+        std::array<uint64_t, 4> bad{};
+        std::array<TranspositionTable::Stats, 4> counters{};
+        const auto start = std::chrono::steady_clock::now();
+        pool.parallelFor(4, [&](int t, int) {
+            Pcg32 rng(static_cast<uint64_t>(t) + 1);
+            for (int i = 0; i < per_thread; ++i) {
+                const uint64_t key = mix64((static_cast<uint64_t>(rng.next()) << 32 | rng.next()) % key_space);
+                const double score = static_cast<double>(key >> 12);
+                const int depth = static_cast<int>(key % 200);
+                TranspositionTable::Entry entry;
+                if (table.probe(key, entry, counters[t]) && (entry.score != score || entry.depth != depth)) bad[t]++;
+                table.store(key, score, depth, counters[t]);
+            }
+        });
+        const double seconds = secondsSince(start);
+        TranspositionTable::Stats stats;
+        for (const auto& thread_counters : counters) stats += thread_counters;
+        const uint64_t mismatches = bad[0] + bad[1] + bad[2] + bad[3];
+        std::printf("concurrent stress (4 threads, %zu slots, %llu keys): %llu probes, hit rate %.1f%%, "
+                    "%llu mismatches, %.1f M ops/s\n",
+                    table.capacity(), static_cast<unsigned long long>(key_space),
+                    static_cast<unsigned long long>(stats.probes), stats.hitRate() * 100,
+                    static_cast<unsigned long long>(mismatches), 2.0 * stats.probes / seconds / 1e6);
+        ok &= mismatches == 0 && stats.probes == 4ull * per_thread;
+    }
+
+    // Search roots: boards from random play and a random piece sequence each
+    std::vector<Root> roots;
+    {
+        Pcg32 rng(47);
+        auto gen = std::make_unique<MoveGenerator>();
+        while (roots.size() < 24) {
+            Board board;
+            const int moves = 4 + static_cast<int>(rng.bounded(12));
+            for (int move = 0; move < moves; ++move) {
+                if (gen->generate(board, createRandomTetromino(rng, {Board::SPAWN_X, Board::SPAWN_Y})) == 0) break;
+                board.placePiece(gen->piece((*gen)[static_cast<int>(rng.bounded(static_cast<uint32_t>(gen->size())))]));
+                board.clearLines();
+            }
+            if (board.isGameOver()) continue;
+            Root root{board, {}};
+            for (auto& piece : root.pieces) piece = static_cast<TetrominoType>(rng.bounded(PIECE_TYPE_COUNT));
+            roots.push_back(root);
+        }
+    }
+
+    const Evaluator evaluator;
+    std::vector<std::unique_ptr<SearchContext>> contexts;
+    for (int w = 0; w < pool.size(); ++w) {
+        auto ctx = std::make_unique<SearchContext>();
+        for (auto& gen : ctx->generators) gen = std::make_unique<MoveGenerator>();
+        ctx->evaluator = &evaluator;
+        contexts.push_back(std::move(ctx));
+    }
+
+    TranspositionTable::Stats stats;
+    auto runSearch = [&](TranspositionTable* table, std::vector<double>& values) {
+        values.assign(roots.size(), 0.0);
+        for (auto& ctx : contexts) {
+            ctx->table = table;
+            ctx->nodes = 0;
+            ctx->table_stats = TranspositionTable::Stats{};
+        }
+        pool.parallelFor(static_cast<int>(roots.size()), [&](int r, int worker) {
+            SearchContext& ctx = *contexts[worker];
+            ctx.root = &roots[r];
+            Board board = roots[r].board;
+            values[r] = search(board, 0, TetrominoType::NONE, DEPTH, ctx);
+        });
+        uint64_t nodes = 0;
+        stats = TranspositionTable::Stats{};
+        for (const auto& ctx : contexts) {
+            nodes += ctx->nodes;
+            stats += ctx->table_stats;
+        }
+        return nodes;
+    };
+
+    std::vector<double> reference;
+    auto start = std::chrono::steady_clock::now();
+    const uint64_t plain_nodes = runSearch(nullptr, reference);
+    const double plain_s = secondsSince(start);
+    std::printf("search without table: %zu roots, %llu placements, %.2f s\n", roots.size(),
+                static_cast<unsigned long long>(plain_nodes), plain_s);
+
+    for (size_t megabytes : {1, 4, 16, 64}) {
+        TranspositionTable table(megabytes);
+        std::vector<double> values;
+        start = std::chrono::steady_clock::now();
+        const uint64_t nodes = runSearch(&table, values);
+        const double seconds = secondsSince(start);
+        const bool same = values == reference;
+        std::printf("%3zu MB (%8zu slots): hit rate %5.1f%%, occupancy %5.1f%%, evictions %8llu, "
+                    "placements %llu, %.2f s (%.2fx), values %s\n",
+                    megabytes, table.capacity(), stats.hitRate() * 100, table.occupancy() * 100,
+                    static_cast<unsigned long long>(stats.evictions), static_cast<unsigned long long>(nodes),
+                    seconds, plain_s / seconds, same ? "match" : "DIFFER");
+        ok &= same;
+    }
+
+    return ok ? 0 : 1;
+}
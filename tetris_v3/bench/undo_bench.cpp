@@ -0,0 +1,237 @@
+/**
+ * @file undo_bench.cpp
+ * @brief applyPiece/undo and snapshot/restore vs copying the board
+ *
+ * Random positions come from greedy hard-drop games (lowest landing column)
+ * with line clears. Every legal hard drop of every piece is tried on each
+ * position. "Before" is the copy a search makes today (copy the Board,
+ * place, clear). "After" is applyPiece followed by undo on the same board.
+ * A snapshot/restore round trip per position is timed separately, since it
+ * rebuilds the derived state and is meant for saving positions, not for
+ * stepping through moves. Correctness checks run
+ * first. applyPiece must reach the same board as the copy, including
+ * heights, statistics and hash. undo must restore the original exactly,
+ * also after random move sequences undone in reverse. A snapshot restored
+ * into a fresh board must reproduce the source board. The checks also run
+ * on a 24x30 board, whose packed colors span two 64-bit words per row.
+ * Timings are taken on the standard board and on a 48x64 board, where a
+ * copy costs far more while an undo still touches only a few rows.
+ */
+
+#include "Board.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace Tetris;
+
+namespace {
+
+template <typename BoardType>
+bool sameBoard(const BoardType& a, const BoardType& b) {
+    for (int y = 0; y < BoardType::HEIGHT; ++y) {
+        for (int x = 0; x < BoardType::WIDTH; ++x) {
+            const Cell& ca = a.getCell(x, y);
+            const Cell& cb = b.getCell(x, y);
+            if (ca.occupied != cb.occupied || ca.color != cb.color) return false;
+        }
+    }
+    return a.getRowMasks() == b.getRowMasks() && a.getColumnHeights() == b.getColumnHeights() &&
+           a.stats() == b.stats() && a.hash() == b.hash() && a.verifyStats() && a.hash() == a.computeHash();
+}
+
+// Every hard drop (piece type, rotation, column) that fits on the board
+template <typename BoardType>
+std::vector<Tetromino> legalDrops(const BoardType& board) {
+    std::vector<Tetromino> drops;
+    for (int type = 0; type < PIECE_TYPE_COUNT; ++type) {
+        for (int rot = 0; rot < 4; ++rot) {
+            for (int x = -2; x < BoardType::WIDTH; ++x) {
+                Tetromino piece(static_cast<TetrominoType>(type), {x, 0});
+                for (int r = 0; r < rot; ++r) piece.rotateClockwise();
+                if (!board.canPlacePiece(piece)) continue;
+                piece.setPosition(board.findDropPosition(piece));
+                drops.push_back(piece);
+            }
+        }
+    }
+    return drops;
+}
+
+template <typename BoardType>
+std::vector<BoardType> makePositions(std::mt19937& rng, int count) {
+    std::uniform_int_distribution<int> type_dist(0, PIECE_TYPE_COUNT - 1);
+    std::uniform_int_distribution<int> rot_dist(0, 3);
+    std::vector<BoardType> positions;
+    BoardType board;
+    while (static_cast<int>(positions.size()) < count) {
+        Tetromino piece(static_cast<TetrominoType>(type_dist(rng)), {BoardType::SPAWN_X, BoardType::SPAWN_Y});
+        for (int r = rot_dist(rng); r > 0; --r) piece.rotateClockwise();
+        if (!board.canPlacePiece(piece)) {
+            board.reset();
+            continue;
+        }
+        // Land in whichever column lets the piece fall furthest, which keeps rows filling
+        Position best = board.findDropPosition(piece);
+        for (int x = -2; x < BoardType::WIDTH; ++x) {
+            const Tetromino shifted = piece.withPosition({x, BoardType::SPAWN_Y});
+            if (!board.canPlacePiece(shifted)) continue;
+            const Position landing = board.findDropPosition(shifted);
+            if (landing.y > best.y) best = landing;
+        }
+        piece.setPosition(best);
+        board.placePiece(piece);
+        board.clearLines();
+        positions.push_back(board);
+    }
+    return positions;
+}
+
+struct CheckResult {
+    long moves{0};
+    long lines{0};
+    long mismatches{0};
+};
+
+template <typename BoardType>
+CheckResult check(std::mt19937& rng, int count) {
+    CheckResult result;
+    typename BoardType::UndoRecord record;
+    for (const BoardType& position : makePositions<BoardType>(rng, count)) {
+        // Snapshot round trip into a board with unrelated contents
+        BoardType restored = makePositions<BoardType>(rng, 1).front();
+        restored.restore(position.snapshot());
+        result.mismatches += !sameBoard(restored, position) || restored.snapshot() != position.snapshot();
+
+        // Every single move: apply matches copy + place + clear, undo restores
+        BoardType board = position;
+        for (const Tetromino& piece : legalDrops(board)) {
+            BoardType copy = board;
+            copy.placePiece(piece);
+            copy.clearLines();
+            board.applyPiece(piece, record);
+            result.moves++;
+            result.lines += record.lines_cleared;
+            result.mismatches += !sameBoard(board, copy);
+            board.undo(record);
+            result.mismatches += !sameBoard(board, position);
+        }
+
+        // A random line of play undone move by move, checking every earlier state
+        std::vector<BoardType> path{board};
+        std::vector<typename BoardType::UndoRecord> records;
+        for (int depth = 0; depth < 8; ++depth) {
+            const auto drops = legalDrops(board);
+            if (drops.empty()) break;
+            records.emplace_back();
+            board.applyPiece(drops[std::uniform_int_distribution<size_t>(0, drops.size() - 1)(rng)], records.back());
+            path.push_back(board);
+        }
+        while (!records.empty()) {
+            board.undo(records.back());
+            records.pop_back();
+            path.pop_back();
+            result.mismatches += !sameBoard(board, path.back());
+        }
+    }
+    return result;
+}
+
+template <typename BoardType>
+struct Workload {
+    BoardType board;
+    std::vector<Tetromino> drops;
+};
+
+template <typename BoardType, typename Fn>
+double nanosPerMove(const std::vector<Workload<BoardType>>& work, int rounds, Fn&& fn) {
+    long moves = 0;
+    for (const auto& item : work) moves += static_cast<long>(item.drops.size());
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) fn();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (static_cast<double>(moves) * rounds);
+}
+
+template <typename BoardType>
+void timeMoves(std::mt19937& rng, int rounds) {
+    std::vector<Workload<BoardType>> work;
+    long clearing = 0;
+    long total = 0;
+    for (const BoardType& position : makePositions<BoardType>(rng, 256)) {
+        Workload<BoardType> item{position, legalDrops(position)};
+        for (const auto& piece : item.drops) {
+            BoardType copy = position;
+            copy.placePiece(piece);
+            clearing += copy.clearLines() > 0;
+        }
+        total += static_cast<long>(item.drops.size());
+        work.push_back(std::move(item));
+    }
+
+    volatile uint64_t sink = 0;
+    const double copy_ns = nanosPerMove(work, rounds, [&] {
+        uint64_t sum = 0;
+        for (const auto& item : work) {
+            for (const auto& piece : item.drops) {
+                BoardType copy = item.board;
+                copy.placePiece(piece);
+                copy.clearLines();
+                sum += copy.hash();
+            }
+        }
+        sink = sink + sum;
+    });
+    const double undo_ns = nanosPerMove(work, rounds, [&] {
+        uint64_t sum = 0;
+        typename BoardType::UndoRecord record;
+        for (auto& item : work) {
+            for (const auto& piece : item.drops) {
+                item.board.applyPiece(piece, record);
+                sum += item.board.hash();
+                item.board.undo(record);
+            }
+        }
+        sink = sink + sum;
+    });
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        uint64_t sum = 0;
+        for (auto& item : work) {
+            item.board.restore(item.board.snapshot());
+            sum += item.board.hash();
+        }
+        sink = sink + sum;
+    }
+    const double snapshot_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                               (static_cast<double>(work.size()) * rounds);
+
+    std::printf("%dx%d: %ld moves over %zu positions, %.1f%% clear lines\n", BoardType::WIDTH, BoardType::HEIGHT,
+                total, work.size(), 100.0 * static_cast<double>(clearing) / static_cast<double>(total));
+    std::printf("  %-18s %8.1f ns/move   %7.2f M moves/s\n", "copy+place+clear", copy_ns, 1e3 / copy_ns);
+    std::printf("  %-18s %8.1f ns/move   %7.2f M moves/s   speedup %5.1fx\n",
+                "apply+undo", undo_ns, 1e3 / undo_ns, copy_ns / undo_ns);
+    std::printf("  %-18s %8.1f ns/position\n", "snapshot+restore", snapshot_ns);
+    std::printf("  bytes: board %zu   Snapshot %zu   UndoRecord %zu\n", sizeof(BoardType),
+                sizeof(typename BoardType::Snapshot), sizeof(typename BoardType::UndoRecord));
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 rng(31337);
+    const CheckResult standard = check<Board>(rng, 2000);
+    const CheckResult wide = check<BasicBoard<24, 30>>(rng, 300);
+    if (standard.mismatches != 0 || wide.mismatches != 0) {
+        std::printf("apply/undo or snapshot/restore diverged on %ld checks\n", standard.mismatches + wide.mismatches);
+        return 1;
+    }
+    std::printf("%ld moves (%ld lines) on 10x20 and %ld moves (%ld lines) on 24x30: "
+                "apply, undo and snapshot round trips identical\n",
+                standard.moves, standard.lines, wide.moves, wide.lines);
+
+    timeMoves<Board>(rng, 200);
+    timeMoves<BasicBoard<48, 64>>(rng, 10);
+    return 0;
+}
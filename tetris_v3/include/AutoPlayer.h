@@ -0,0 +1,214 @@
+#pragma once
+
+#include "Board.h"
+#include "Evaluator.h"
+#include "GameSimulation.h"
+#include "Input.h"
+#include "MctsSearch.h"
+#include "MoveGenerator.h"
+#include "PieceQueue.h"
+#include "Tetromino.h"
+#include "ThreadPool.h"
+#include "TranspositionTable.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Tetris {
+
+/**
+ * @brief Computer player: beam search over the visible pieces, one input per call
+ *
+ * When a new piece appears the player plans where it goes. Every known
+ * piece (the current one, the next one and the held one) is placed in
+ * turn: each level of the search expands the kept boards with every
+ * placement the MoveGenerator finds for each piece the queue and hold
+ * allow, scores the results with the Evaluator, and keeps the best
+ * beam_width of them. The current piece's move leading to the best final
+ * board is played. Boards of one level are expanded in parallel on a
+ * ThreadPool, each worker with its own generator and scratch board;
+ * candidates are ranked by a total order, so the choice does not depend
+ * on the thread count. Levels after the first are only started while
+ * the move budget lasts.
+ *
+ * With table_megabytes set, placement scores are cached in a
+ * TranspositionTable shared by the workers and kept across decisions,
+ * keyed by the resulting board, the piece to place next, the held piece
+ * and the lines cleared so far: the beam reaches the same board through
+ * different move orders, and the next decision searches many of the
+ * boards the last one did. A cached score equals the one the Evaluator
+ * would return, so the table changes how fast the player is, never what
+ * it plays. It is off by default: about one placement in six hits, and
+ * with the default weights a probe costs about as much as the
+ * evaluation it saves (autoplay_bench compares the two).
+ *
+ * With Search::MCTS the plan comes from an MctsSearch instead, on the
+ * same threads and within the same move budget.
+ *
+ * nextAction() then walks the planned path one input per call. It
+ * regenerates placements from wherever the piece is now, so gravity
+ * between calls does no harm, and replans if the target became
+ * unreachable. The player only reads a GameSimulation, so it drives the
+ * interactive game in place of the keyboard as well as headless runs.
+ */
+class AutoPlayer {
+public:
+    /**
+     * @brief How moves are planned
+     */
+    enum class Search : uint8_t {
+        BEAM = 0,                                        // Beam search over the known pieces
+        MCTS                                             // Monte Carlo tree search with rollouts
+    };
+
+    /**
+     * @brief Search settings
+     */
+    struct Config {
+        Search search{Search::BEAM};
+        int beam_width{32};                              // Boards kept per level
+        int threads{0};                                  // Search threads (0 = one per hardware thread)
+        std::chrono::milliseconds move_budget{50};       // Time to plan one piece; the first level always completes
+        bool use_hold{true};                             // Consider holding (if the game allows it)
+        size_t table_megabytes{0};                       // Placement score cache (0 = none)
+        Evaluator::Weights weights{Evaluator::defaultWeights()};
+        MctsSearch::Config mcts;                         // Used with Search::MCTS
+
+        Config() = default;
+    };
+
+    /**
+     * @brief Planned move for the current piece
+     */
+    struct Decision {
+        bool hold{false};                                // Hold first, then place the piece that comes out
+        TetrominoType piece{TetrominoType::NONE};        // Piece to place
+        Position position;                               // Frame position it locks at
+        Rotation rotation{Rotation::NORTH};
+        double score{0.0};                               // Score of the best final board
+        int depth{0};                                    // Pieces the search looked at
+    };
+
+    /**
+     * @brief Search counters since construction
+     */
+    struct Stats {
+        uint64_t decisions{0};                           // think() calls
+        uint64_t boards_scored{0};                       // Placements scored, table hits included
+        uint64_t table_hits{0};                          // Placements scored from the table instead
+        uint64_t budget_cutoffs{0};                      // Searches stopped early by the move budget
+        uint64_t rollouts{0};                            // MCTS rollouts
+    };
+
+    /**
+     * @brief Construct a player with default settings
+     */
+    AutoPlayer();
+
+    /**
+     * @brief Construct a player
+     * @param config Search settings
+     * @throws std::invalid_argument If beam_width is not positive
+     */
+    explicit AutoPlayer(const Config& config);
+    ~AutoPlayer();
+
+    AutoPlayer(const AutoPlayer&) = delete;
+    AutoPlayer& operator=(const AutoPlayer&) = delete;
+
+    /**
+     * @brief Choose the input for this tick
+     * @param simulation Game to play (read only; the caller applies the action)
+     * @return Action to apply (InputAction::NONE once the game is over)
+     */
+    [[nodiscard]] InputAction nextAction(const GameSimulation& simulation);
+
+    /**
+     * @brief Plan the current piece's move from scratch
+     * @param simulation Game to plan for
+     * @return Best move found
+     */
+    [[nodiscard]] Decision think(const GameSimulation& simulation);
+
+    /**
+     * @brief Forget the current plan (call when starting a new game)
+     */
+    void reset() noexcept;
+
+    [[nodiscard]] const Config& getConfig() const noexcept { return config_; }
+    [[nodiscard]] const Stats& getStats() const noexcept { return stats_; }
+    [[nodiscard]] int threadCount() const noexcept { return pool_.size(); }
+
+private:
+    // Known pieces: current, next and held
+    static constexpr int MAX_DEPTH = 3;
+
+    struct Node {
+        Board board;
+        TetrominoType hold{TetrominoType::NONE};
+        int next{0};                                     // Queue index of the first unplaced piece
+        int lines{0};                                    // Lines cleared along the path
+        double score{0.0};
+        Decision first;                                  // Root move of the path
+    };
+
+    struct Candidate {
+        double score;
+        int parent;                                      // Index in the current beam
+        int order;                                       // Position among the parent's children (tie-break)
+        Placement placement;
+        TetrominoType piece;
+        TetrominoType hold;
+        int next;
+        int lines;
+        bool held;                                       // Took the piece out of hold at the root
+    };
+
+    struct Worker {
+        std::unique_ptr<MoveGenerator> generator;
+        Board board;
+    };
+
+    Config config_;
+    Evaluator evaluator_;
+    ThreadPool pool_;
+    std::vector<Worker> workers_;
+    std::unique_ptr<MctsSearch> mcts_;                   // Only with Search::MCTS
+    std::unique_ptr<TranspositionTable> table_;          // Null if table_megabytes is 0
+    Stats stats_;
+
+    // Search storage, kept between decisions so planning does not allocate once warm
+    std::vector<Node> beam_;
+    std::vector<Node> next_beam_;
+    std::vector<std::vector<Candidate>> children_;       // Per beam node
+    std::vector<Candidate> ranked_;
+    std::vector<uint64_t> scored_;                       // Per worker
+    std::vector<TranspositionTable::Stats> table_stats_; // Per worker
+    PieceQueue queue_;
+    bool root_hold_{false};                              // Hold allowed for the current piece
+    bool later_hold_{false};                             // Hold allowed for the pieces after it
+    Tetromino root_piece_;
+
+    // Plan being played
+    Decision plan_;
+    bool has_plan_{false};
+    bool pending_hold_{false};
+    int plan_pieces_{-1};                                // total_pieces when planned
+    bool plan_can_hold_{false};
+    MoveGenerator::Path path_;
+
+    /**
+     * @brief Score every child of one beam node into children_[index]
+     */
+    void expand(int index, int level, int worker);
+
+    /**
+     * @brief Score the placements of one piece on a node's board
+     */
+    void expandPiece(const Node& node, int index, Worker& worker, const Tetromino& piece,
+                     const PieceChoice& choice, int worker_index);
+};
+
+} // namespace Tetris
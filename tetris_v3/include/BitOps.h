@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Tetris {
+
+/**
+ * @brief Index of the lowest set bit
+ * @param value Non-zero value
+ * @return Number of trailing zero bits
+ */
+[[nodiscard]] inline int countTrailingZeros(uint64_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return static_cast<int>(index);
+#else
+    int count = 0;
+    while (!(value & 1)) {
+        value >>= 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+
+/**
+ * @brief Index of the highest set bit
+ * @param value Non-zero value
+ * @return Bit index (0 for value 1)
+ */
+[[nodiscard]] inline int highestSetBit(uint64_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return static_cast<int>(index);
+#else
+    int index = 0;
+    while (value >>= 1) {
+        ++index;
+    }
+    return index;
+#endif
+}
+
+/**
+ * @brief Number of set bits
+ * @param value Any value
+ * @return Population count
+ */
+[[nodiscard]] inline int popCount(uint64_t value) noexcept {
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__POPCNT__)
+    return __builtin_popcountll(value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return static_cast<int>(__popcnt64(value));
+#else
+    // Without the popcnt instruction the builtin is a library call; this
+    // branch-free bit-slice sum is inlined and several times faster
+    value -= (value >> 1) & 0x5555555555555555ULL;
+    value = (value & 0x3333333333333333ULL) + ((value >> 2) & 0x3333333333333333ULL);
+    value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<int>((value * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+} // namespace Tetris
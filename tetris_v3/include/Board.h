@@ -1,10 +1,15 @@
 #pragma once
 
+#include "BitOps.h"
+#include "BoardHash.h"
 #include "Tetromino.h"
 #include <array>
 #include <vector>
 #include <cstdint>
 #include <functional>
+#include <limits>
+#include <optional>
+#include <type_traits>
 
 namespace Tetris {
 
@@ -32,26 +37,125 @@ struct Cell {
 };
 
 /**
- * @brief Game board class managing the 10x20 Tetris playing field
+ * @brief Board statistics for AI or analysis
+ */
+struct BoardStats {
+    int total_height{0};        // Sum of all column heights
+    int max_height{0};          // Highest column
+    int holes{0};               // Count of empty cells below occupied cells
+    int bumpiness{0};           // Sum of height differences between adjacent columns
+    int complete_lines{0};      // Number of complete lines
+    
+    bool operator==(const BoardStats& other) const noexcept {
+        return total_height == other.total_height && max_height == other.max_height &&
+               holes == other.holes && bumpiness == other.bumpiness &&
+               complete_lines == other.complete_lines;
+    }
+    bool operator!=(const BoardStats& other) const noexcept { return !(*this == other); }
+};
+
+/**
+ * @brief Smallest unsigned word with one bit per board column
+ * @tparam Width Board width in columns (at most 64)
+ */
+template <int Width>
+using RowWord = std::conditional_t<(Width <= 16), uint16_t,
+                std::conditional_t<(Width <= 32), uint32_t, uint64_t>>;
+
+/**
+ * @brief Game board class managing a Width x Height Tetris playing field
  * 
  * This class handles the game board state, piece placement validation,
- * line clearing mechanics, and collision detection. Uses efficient
- * data structures and algorithms for optimal performance.
+ * line clearing mechanics, and collision detection. Occupancy is kept in
+ * a bitboard (one RowWord mask per row, bit x = column x) alongside the
+ * color grid, so collision and line queries are a few mask operations.
+ * Column heights are maintained incrementally, which makes the hard-drop
+ * distance a constant-time lookup against the piece's bottom profile.
+ * 
+ * The dimensions are template parameters so every board size gets its own
+ * fully specialized collision and line-clear code; Board is the standard
+ * 10x20 field.
+ * 
+ * @tparam Width Number of columns (4 to 64)
+ * @tparam Height Number of rows (4 to 64)
  */
-class Board {
+template <int Width, int Height>
+class BasicBoard {
 public:
-    static constexpr int WIDTH = 10;
-    static constexpr int HEIGHT = 20;
+    static_assert(Width >= 4 && Width <= 64, "Pieces need 4 columns and a row must fit in 64 bits");
+    static_assert(Height >= 4 && Height <= 64, "clearLines keeps one bit per row in a 64-bit mask");
+    
+    static constexpr int WIDTH = Width;
+    static constexpr int HEIGHT = Height;
     static constexpr int SPAWN_X = WIDTH / 2 - 2; // Center spawn position
     static constexpr int SPAWN_Y = 0;
     
+    using RowMask = RowWord<Width>;
+    static constexpr RowMask FULL_ROW =
+        static_cast<RowMask>(std::numeric_limits<RowMask>::max() >> (std::numeric_limits<RowMask>::digits - WIDTH));
+    
     using GridType = std::array<std::array<Cell, WIDTH>, HEIGHT>;
+    using RowMaskArray = std::array<RowMask, HEIGHT>;
+    using HeightArray = std::array<int, WIDTH>;
+    using BoardStats = Tetris::BoardStats;
+    
+    /**
+     * @brief Wall kick offsets tried in order when a plain rotation collides (simplified SRS)
+     */
+    static constexpr std::array<CellOffset, 5> KICK_OFFSETS = {{
+        {-1, 0}, {1, 0}, {0, -1}, {-1, -1}, {1, -1}
+    }};
     using LineCallback = std::function<void(int line_count, int level)>;
     
+    /**
+     * @brief One row of cell colors packed as 3-bit codes (see colorCode()), cell x in bits 3x..3x+2 of its word
+     */
+    using ColorWord = std::conditional_t<(3 * Width <= 32), uint32_t, uint64_t>;
+    static constexpr int CELLS_PER_COLOR_WORD = std::numeric_limits<ColorWord>::digits / 3;
+    using PackedColorRow = std::array<ColorWord, (Width + CELLS_PER_COLOR_WORD - 1) / CELLS_PER_COLOR_WORD>;
+    
+    /**
+     * @brief Compact copy of the board contents (occupancy and colors, no derived state)
+     * 
+     * 120 bytes for the standard board, against roughly 640 for a BasicBoard.
+     * Heights, statistics and the hash are rebuilt by restore().
+     */
+    struct Snapshot {
+        RowMaskArray rows{};
+        std::array<PackedColorRow, HEIGHT> colors{};
+        
+        bool operator==(const Snapshot& other) const noexcept {
+            return rows == other.rows && colors == other.colors;
+        }
+        bool operator!=(const Snapshot& other) const noexcept { return !(*this == other); }
+    };
+    
+    /**
+     * @brief Everything applyPiece() changed, so undo() can put the board back
+     * 
+     * Holds the derived state from before the move, the cells the piece added
+     * (one mask per row it covers) and the colors of the rows it cleared.
+     * Rows that only moved during the clear are not stored; undo() moves
+     * them back.
+     */
+    struct UndoRecord {
+        HeightArray heights{};                       // Derived state before the move
+        BoardStats stats;
+        uint64_t hash{0};
+        int filled_cells{0};
+        int piece_top{0};                            // Board row of piece_rows[0]
+        std::array<RowMask, 4> piece_rows{};         // Cells the piece added, per row
+        uint8_t piece_color{0};
+        int lines_cleared{0};
+        uint64_t cleared_rows{0};                    // Bit y set for each cleared row (rows before the clear)
+        int clear_top{0};                            // Top row of the stack when it was cleared
+        std::array<PackedColorRow, 4> cleared_colors{}; // Colors of the cleared rows, lowest row first
+    };
+    
     /**
      * @brief Construct an empty board
      */
-    Board();
+    BasicBoard();
     
     /**
      * @brief Clear the entire board
@@ -86,13 +190,6 @@ public:
      */
     [[nodiscard]] const Cell& getCell(const Position& pos) const;
     
-    /**
-     * @brief Get cell at specified position
-     * @param pos Position to get
-     * @return Reference to the cell (non-const version)
-     */
-    [[nodiscard]] Cell& getCell(const Position& pos);
-    
     /**
      * @brief Get cell at specified coordinates
      * @param x X coordinate
@@ -117,6 +214,14 @@ public:
      */
     [[nodiscard]] bool canPlacePiece(const Tetromino& piece, const Position& pos, Rotation rot) const;
     
+    /**
+     * @brief Find where a piece ends up when rotated, trying wall kicks if needed
+     * @param piece The Tetromino to rotate (its current position is the origin)
+     * @param rot Target rotation
+     * @return Position after rotation, or std::nullopt if every kick collides
+     */
+    [[nodiscard]] std::optional<Position> findRotationPosition(const Tetromino& piece, Rotation rot) const;
+    
     /**
      * @brief Place a Tetromino on the board permanently
      * @param piece The Tetromino to place
@@ -149,21 +254,24 @@ public:
      */
     [[nodiscard]] const GridType& getGrid() const noexcept { return grid_; }
     
+    /**
+     * @brief Get the occupancy bitboard
+     * @return Const reference to the per-row occupancy masks (bit x = column x)
+     */
+    [[nodiscard]] const RowMaskArray& getRowMasks() const noexcept { return rows_; }
+    
     /**
      * @brief Find the lowest valid position for a piece (hard drop calculation)
+     * 
+     * Compares the piece's column-bottom profile with the maintained column
+     * heights. Only a piece tucked under an overhang falls back to stepping
+     * down row by row.
+     * 
      * @param piece The Tetromino to drop
      * @return Position where the piece would land
      */
     [[nodiscard]] Position findDropPosition(const Tetromino& piece) const;
     
-    /**
-     * @brief Get a preview of the board with a piece placed (for ghost piece rendering)
-     * @param piece The Tetromino to preview
-     * @param ghost_color Color index for ghost piece (default 8 for gray)
-     * @return Copy of board with ghost piece overlaid
-     */
-    [[nodiscard]] Board getPreviewBoard(const Tetromino& piece, uint8_t ghost_color = 8) const;
-    
     /**
      * @brief Check how many lines are currently complete
      * @return Number of complete lines
@@ -190,23 +298,93 @@ public:
     [[nodiscard]] int getColumnHeight(int column) const;
     
     /**
-     * @brief Get board statistics for AI or analysis
-     * @return Structure containing board metrics
+     * @brief Get the surface profile (height of every column)
+     * @return Const reference to the incrementally maintained column heights
      */
-    struct BoardStats {
-        int total_height{0};        // Sum of all column heights
-        int max_height{0};          // Highest column
-        int holes{0};               // Count of empty cells below occupied cells
-        int bumpiness{0};           // Sum of height differences between adjacent columns
-        int complete_lines{0};      // Number of complete lines
-    };
+    [[nodiscard]] const HeightArray& getColumnHeights() const noexcept { return heights_; }
     
     /**
-     * @brief Calculate board statistics
+     * @brief Calculate board statistics from scratch
+     *
+     * Column heights come from a scan of the row masks, not from the
+     * maintained heights, so the result is an independent check of stats().
+     *
      * @return BoardStats structure with current metrics
      */
     [[nodiscard]] BoardStats calculateStats() const;
     
+    /**
+     * @brief Get the incrementally maintained board statistics
+     * 
+     * Updated per touched column as cells are set and once per line clear,
+     * so reading it costs nothing. Build with TETRIS_VERIFY_STATS to check it
+     * against calculateStats() after every placement and clear.
+     * 
+     * @return Const reference to the current metrics
+     */
+    [[nodiscard]] const BoardStats& stats() const noexcept { return stats_; }
+    
+    /**
+     * @brief Check the maintained statistics and column heights against a full recomputation
+     * @return True if stats() matches calculateStats() and every column height matches a scan
+     */
+    [[nodiscard]] bool verifyStats() const;
+    
+    /**
+     * @brief Get the 64-bit hash of the occupancy
+     * 
+     * XOR of rowHash() over all rows, maintained as the board changes: per
+     * covered row when a piece is placed, and per moved row when lines are
+     * cleared (one row key, two rotations; rows up to ROW_KEY_TABLE_MAX_WIDTH
+     * cells wide look the key up in a table). Reading it is a plain load, so
+     * a shared Board can be hashed from several threads. Colors are not
+     * hashed, so boards with the same shape hash equal whichever pieces built
+     * them. An empty board hashes to 0.
+     * 
+     * @return Current hash
+     */
+    [[nodiscard]] uint64_t hash() const noexcept { return hash_; }
+    
+    /**
+     * @brief Hash the occupancy from scratch
+     * @return XOR of rowHash() over all rows (equal to hash() unless it drifted)
+     */
+    [[nodiscard]] uint64_t computeHash() const noexcept;
+    
+    /**
+     * @brief Copy the board contents into a compact snapshot
+     * @return Row masks plus 3-bit packed colors
+     */
+    [[nodiscard]] Snapshot snapshot() const noexcept;
+    
+    /**
+     * @brief Replace the board contents with a snapshot and rebuild heights, statistics and hash
+     * @param snapshot Snapshot taken from a board of the same size
+     */
+    void restore(const Snapshot& snapshot);
+    
+    /**
+     * @brief Place a piece and clear the lines it completes, recording how to undo both
+     * 
+     * Meant for search: the line-clear callback is not called, and undo()
+     * only touches the rows the move changed instead of copying the board.
+     * 
+     * @param piece The Tetromino to place
+     * @param record Filled with what undo() needs (left unchanged if the piece does not fit)
+     * @return True if the piece was placed
+     * @throws std::logic_error If the board already has complete lines
+     */
+    bool applyPiece(const Tetromino& piece, UndoRecord& record);
+    
+    /**
+     * @brief Take back the most recent applyPiece() still in effect
+     * 
+     * Moves are undone in reverse order of application.
+     * 
+     * @param record Record filled by that applyPiece()
+     */
+    void undo(const UndoRecord& record);
+    
     /**
      * @brief Reset board to initial empty state
      */
@@ -214,13 +392,108 @@ public:
 
 private:
     GridType grid_;
+    RowMaskArray rows_{};          // Occupancy bitboard, kept in sync with grid_
+    HeightArray heights_{};        // Column heights (surface profile), kept in sync with rows_
+    BoardStats stats_;             // Metrics maintained alongside heights_
+    int filled_cells_{0};          // Occupied cell count (holes = total height - filled cells)
+    uint64_t hash_{0};             // XOR of rowHash() over rows_
     LineCallback line_clear_callback_;
     
     /**
-     * @brief Remove a specific line and shift everything down
-     * @param line Line index to remove
+     * @brief Recompute all column heights and the statistics derived from them after a clear
+     */
+    void recomputeHeights() noexcept;
+    
+    /**
+     * @brief Rebuild the statistics derived from the column heights
+     */
+    void updateHeightStats() noexcept;
+    
+    /**
+     * @brief Raise a column's height and update the affected statistics
+     * @param x Column index
+     * @param height New height (greater than the current one)
+     */
+    void raiseColumn(int x, int height) noexcept;
+    
+    /**
+     * @brief Write a piece that fits into grid, bitboard, stats and hash
+     * @param piece The Tetromino to place (canPlacePiece must hold)
+     */
+    void placeCells(const Tetromino& piece) noexcept;
+    
+    /**
+     * @brief Set an empty cell's color and mark it occupied in grid, bitboard and stats (not the hash)
+     * @param x X coordinate (must be in bounds)
+     * @param y Y coordinate (must be in bounds)
+     * @param color Color index to store
+     */
+    void setCell(int x, int y, uint8_t color) noexcept;
+    
+    /**
+     * @brief rowHash() of a row, with the key looked up in ROW_KEY_TABLE on boards narrow enough
+     * @param y Row index
+     * @param mask Occupancy mask of the row
+     * @return 64-bit contribution
+     */
+    [[nodiscard]] static uint64_t rowContribution(int y, RowMask mask) noexcept {
+        if constexpr (Width <= ROW_KEY_TABLE_MAX_WIDTH) {
+            return rotateRowKey(ROW_KEY_TABLE<Width>[mask], y);
+        } else {
+            return rowHash(y, mask);
+        }
+    }
+    
+    /**
+     * @brief Height of a column found by scanning the row masks from the top
+     * @param column Column index (must be in bounds)
+     * @return Height of the highest occupied cell (0 = empty column)
+     */
+    [[nodiscard]] int scanColumnHeight(int column) const noexcept;
+    
+    /**
+     * @brief Throw if the maintained statistics or hash drifted (TETRIS_VERIFY_STATS builds only)
      */
-    void removeLine(int line);
+    void checkStats() const;
+    
+    /**
+     * @brief Drop every full row, moving each block of rows between full rows down once
+     * @param full_rows Bit y set for each full row y (must be non-zero)
+     */
+    void compactRows(uint64_t full_rows) noexcept;
+    
+    /**
+     * @brief Drop a single full row and lower the column heights without rescanning the stack
+     * @param line The full row
+     */
+    void clearOneRow(int line) noexcept;
+    
+    /**
+     * @brief Find the full rows of the stack
+     * @return Bit y set for each full row y
+     */
+    [[nodiscard]] uint64_t findFullRows() const noexcept;
+    
+    /**
+     * @brief Remove full rows and rebuild the derived state
+     * @param full_rows Bit y set for each full row y (must be non-zero)
+     * @param count Number of bits set in full_rows
+     */
+    void removeFullRows(uint64_t full_rows, int count);
+    
+    /**
+     * @brief Pack one grid row's colors as 3-bit codes
+     * @param y Row index
+     * @return Packed colors
+     */
+    [[nodiscard]] PackedColorRow packColors(int y) const noexcept;
+    
+    /**
+     * @brief Rewrite one grid row from packed colors, taking occupancy from rows_[y]
+     * @param y Row index
+     * @param colors Packed colors
+     */
+    void unpackColors(int y, const PackedColorRow& colors) noexcept;
     
     /**
      * @brief Check bounds for position
@@ -231,23 +504,26 @@ private:
     [[nodiscard]] bool isInBounds(int x, int y) const noexcept {
         return x >= 0 && x < WIDTH && y >= 0 && y < HEIGHT;
     }
-    
-    /**
-     * @brief Get occupied positions for a piece at specific position and rotation
-     * @param piece The piece to check
-     * @param pos Position offset
-     * @param rot Rotation state
-     * @return Vector of absolute positions the piece would occupy
-     */
-    [[nodiscard]] std::vector<Position> getPiecePositions(const Tetromino& piece, 
-                                                          const Position& pos, 
-                                                          Rotation rot) const;
 };
 
+/**
+ * @brief The standard 10x20 board
+ */
+using Board = BasicBoard<10, 20>;
+
 /**
  * @brief Factory function to create a standard Tetris board
  * @return New empty Board instance
  */
 [[nodiscard]] Board createStandardBoard();
 
+} // namespace Tetris
+
+#include "BoardImpl.h"
+
+namespace Tetris {
+
+// Compiled once in Board.cpp
+extern template class BasicBoard<10, 20>;
+
 } // namespace Tetris
\ No newline at end of file
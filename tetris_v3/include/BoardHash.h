@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Tetris {
+
+/**
+ * @brief splitmix64 finalizer: a bijective 64-bit mix with full avalanche
+ * @param value Value to mix
+ * @return Mixed value
+ */
+[[nodiscard]] constexpr uint64_t mix64(uint64_t value) noexcept {
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+    return value;
+}
+
+/**
+ * @brief Salt mixed into every row key, so a one-cell row does not key to a small number
+ */
+inline constexpr uint64_t ROW_KEY_SALT = 0x7e7215c0ffee1234ULL;
+
+/**
+ * @brief Position-independent key of one row's occupancy
+ * @param mask Occupancy mask of the row
+ * @return 64-bit key (0 for an empty row)
+ */
+[[nodiscard]] constexpr uint64_t rowKey(uint64_t mask) noexcept {
+    return mask == 0 ? 0 : mix64(mask ^ ROW_KEY_SALT);
+}
+
+/**
+ * @brief Widest row whose keys are tabulated (2^10 keys, 8 KB)
+ */
+inline constexpr int ROW_KEY_TABLE_MAX_WIDTH = 10;
+
+/**
+ * @brief rowKey() of every mask of a Width-bit row, so a narrow board looks keys up instead of mixing
+ */
+template <int Width>
+inline constexpr std::array<uint64_t, size_t{1} << Width> ROW_KEY_TABLE = [] {
+    static_assert(Width <= ROW_KEY_TABLE_MAX_WIDTH, "row too wide to tabulate");
+    std::array<uint64_t, size_t{1} << Width> keys{};
+    for (size_t mask = 0; mask < keys.size(); ++mask) {
+        keys[mask] = rowKey(mask);
+    }
+    return keys;
+}();
+
+/**
+ * @brief Place a row key (or an XOR of them) y rows further down: rotate it left by y bits
+ *
+ * Rotation distributes over XOR, so rows that all move down by k change
+ * their combined contribution from h to rotateRowKey(h, k).
+ *
+ * @param key Key or XOR of keys
+ * @param y Rows to move down by (0 to 63)
+ * @return Rotated key
+ */
+[[nodiscard]] constexpr uint64_t rotateRowKey(uint64_t key, int y) noexcept {
+    const unsigned shift = static_cast<unsigned>(y) & 63u;
+    return (key << shift) | (key >> ((64u - shift) & 63u));
+}
+
+/**
+ * @brief Hash contribution of one board row
+ *
+ * A board's hash is the XOR of its rows' contributions: the row's key
+ * rotated by its index, so equal masks on different rows hash apart. An
+ * empty row contributes nothing, so only occupied rows have to be tracked.
+ *
+ * @param y Row index (0 to 63)
+ * @param mask Occupancy mask of the row
+ * @return 64-bit contribution
+ */
+[[nodiscard]] constexpr uint64_t rowHash(int y, uint64_t mask) noexcept {
+    return rotateRowKey(rowKey(mask), y);
+}
+
+} // namespace Tetris
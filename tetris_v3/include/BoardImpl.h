@@ -0,0 +1,555 @@
+#pragma once
+
+// BasicBoard member definitions, included at the end of Board.h. The default
+// 10x20 Board is instantiated once in Board.cpp; other sizes wherever used.
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace Tetris {
+
+template <int Width, int Height>
+BasicBoard<Width, Height>::BasicBoard() {
+    clear();
+}
+
+template <int Width, int Height>
+void BasicBoard<Width, Height>::clear() noexcept {
+    for (auto& row : grid_) {
+        for (auto& cell : row) {
+            cell.clear();
+        }
+    }
+    rows_.fill(0);
+    heights_.fill(0);
+    stats_ = BoardStats{};
+    filled_cells_ = 0;
+    hash_ = 0;
+}
+
+template <int Width, int Height>
+void BasicBoard<Width, Height>::reset() noexcept {
+    clear();
+}
+
+template <int Width, int Height>
+bool BasicBoard<Width, Height>::isValidPosition(const Position& pos) const noexcept {
+    return isInBounds(pos.x, pos.y);
+}
+
+template <int Width, int Height>
+bool BasicBoard<Width, Height>::isEmpty(const Position& pos) const noexcept {
+    return isInBounds(pos.x, pos.y) && !(rows_[pos.y] & (RowMask{1} << pos.x));
+}
+
+template <int Width, int Height>
+bool BasicBoard<Width, Height>::isOccupied(const Position& pos) const noexcept {
+    return isInBounds(pos.x, pos.y) && (rows_[pos.y] & (RowMask{1} << pos.x));
+}
+
+template <int Width, int Height>
+const Cell& BasicBoard<Width, Height>::getCell(const Position& pos) const {
+    if (!isInBounds(pos.x, pos.y)) throw std::out_of_range("Board position out of range");
+    return grid_[pos.y][pos.x];
+}
+
+template <int Width, int Height>
+const Cell& BasicBoard<Width, Height>::getCell(int x, int y) const {
+    if (!isInBounds(x, y)) throw std::out_of_range("Board position out of range");
+    return grid_[y][x];
+}
+
+template <int Width, int Height>
+bool BasicBoard<Width, Height>::canPlacePiece(const Tetromino& piece) const {
+    return canPlacePiece(piece, piece.getPosition(), piece.getRotation());
+}
+
+template <int Width, int Height>
+bool BasicBoard<Width, Height>::canPlacePiece(const Tetromino& piece, const Position& pos, Rotation rot) const {
+    if (!piece.isValid()) return false;
+    const auto& geometry = piece.getGeometry(rot);
+
+    // Bounds come from the precomputed bounding box, collision from the row masks
+    const int left = pos.x + geometry.min_x;
+    if (left < 0 || pos.x + geometry.max_x >= WIDTH ||
+        pos.y + geometry.min_y < 0 || pos.y + geometry.max_y >= HEIGHT) {
+        return false;
+    }
+    for (int y = geometry.min_y; y <= geometry.max_y; ++y) {
+        if (rows_[pos.y + y] & (static_cast<RowMask>(geometry.row_masks[y]) << left)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <int Width, int Height>
+std::optional<Position> BasicBoard<Width, Height>::findRotationPosition(const Tetromino& piece, Rotation rot) const {
+    const Position& origin = piece.getPosition();
+    if (canPlacePiece(piece, origin, rot)) {
+        return origin;
+    }
+    for (const auto& kick : KICK_OFFSETS) {
+        Position test_pos = {origin.x + kick.x, origin.y + kick.y};
+        if (canPlacePiece(piece, test_pos, rot)) {
+            return test_pos;
+        }
+    }
+    return std::nullopt;
+}
+
+template <int Width, int Height>
+bool BasicBoard<Width, Height>::placePiece(const Tetromino& piece) {
+    if (!canPlacePiece(piece)) {
+        return false;
+    }
+    
+    placeCells(piece);
+    checkStats();
+    return true;
+}
+
+template <int Width, int Height>
+void BasicBoard<Width, Height>::placeCells(const Tetromino& piece) noexcept {
+    const auto& geometry = piece.getGeometry();
+    const auto& piece_pos = piece.getPosition();
+    const uint8_t color = piece.getColorIndex();
+
+    // canPlacePiece guarantees every cell is in bounds
+    for (const auto& cell : geometry.cells) {
+        setCell(piece_pos.x + cell.x, piece_pos.y + cell.y, color);
+    }
+    // One hash update per covered row rather than per cell
+    const int left = piece_pos.x + geometry.min_x;
+    for (int y = geometry.min_y; y <= geometry.max_y; ++y) {
+        const int row = piece_pos.y + y;
+        const auto added = static_cast<RowMask>(static_cast<RowMask>(geometry.row_masks[y]) << left);
+        hash_ ^= rowContribution(row, rows_[row] & ~added) ^ rowContribution(row, rows_[row]);
+    }
+}
+
+template <int Width, int Height>
+void BasicBoard<Width, Height>::setCell(int x, int y, uint8_t color) noexcept {
+    grid_[y][x].set(color);
+    rows_[y] |= static_cast<RowMask>(RowMask{1} << x);
+    if (rows_[y] == FULL_ROW) {
+        stats_.complete_lines++;
+    }
+    filled_cells_++;
+    if (HEIGHT - y > heights_[x]) {
+        raiseColumn(x, HEIGHT - y);
+    }
+    stats_.holes = stats_.total_height - filled_cells_;
+}
+
+template <int Width, int Height>
+void BasicBoard<Width, Height>::raiseColumn(int x, int height) noexcept {
+    // Only the two neighbouring height differences can change
+    if (x > 0) {
+        stats_.bumpiness += std::abs(heights_[x - 1] - height) - std::abs(heights_[x - 1] - heights_[x]);
+    }
+    if (x < WIDTH - 1) {
+        stats_.bumpiness += std::abs(height - heights_[x + 1]) - std::abs(heights_[x] - heights_[x + 1]);
+    }
+    stats_.total_height += height - heights_[x];
+    stats_.max_height = std::max(stats_.max_height, height);
+    heights_[x] = height;
+}
+
+template <int Width, int Height>
+void BasicBoard<Width, Height>::checkStats() const {
+#ifdef TETRIS_VERIFY_STATS
+    if (!verifyStats()) {
+        throw std::logic_error("Board statistics diverged from full recomputation");
+    }
+    if (hash_ != computeHash()) {
+        throw std::logic_error("Board hash diverged from full recomputation");
+    }
+#endif
+}
+
+template <int Width, int Height>
+int BasicBoard<Width, Height>::clearLines() {
+    // The maintained line count skips the scan when nothing is full
+    const int cleared_lines = stats_.complete_lines;
+    if (cleared_lines > 0) {
+        removeFullRows(findFullRows(), cleared_lines);
+    }
+    
+    if (cleared_lines > 0 && line_clear_callback_) {
+        // In a real game, level would be passed here.
+        // For now, we pass a placeholder level 1.
+        line_clear_callback_(cleared_lines, 1);
+    }
+    
+    return cleared_lines;
+}
+
+template <int Width, int Height>
+uint64_t BasicBoard<Width, Height>::findFullRows() const noexcept {
+    // One bit per full row (bit y = row y); rows above the stack cannot be full
+    uint64_t full_rows = 0;
+    for (int y = HEIGHT - stats_.max_height; y < HEIGHT; ++y) {
+        if (rows_[y] == FULL_ROW) {
+            full_rows |= uint64_t{1} << y;
+        }
+    }
+    return full_rows;
+}
+
+template <int Width, int Height>
+void BasicBoard<Width, Height>::removeFullRows(uint64_t full_rows, int count) {
+    filled_cells_ -= count * WIDTH;
+    if (count == 1) {
+        clearOneRow(highestSetBit(full_rows));
+    } else {
+        compactRows(full_rows);
+        recomputeHeights();
+    }
+    checkStats();
+}
+
+template <int Width, int Height>
+bool BasicBoard<Width, Height>::applyPiece(const Tetromino& piece, UndoRecord& record) {
+    if (stats_.complete_lines > 0) {
+        throw std::logic_error("applyPiece needs a board without complete lines");
+    }
+    if (!canPlacePiece(piece)) {
+        return false;
+    }
+    
+    record.heights = heights_;
+    record.stats = stats_;
+    record.hash = hash_;
+    record.filled_cells = filled_cells_;
+    
+    const auto& geometry = piece.getGeometry();
+    const Position& piece_pos = piece.getPosition();
+    const int left = piece_pos.x + geometry.min_x;
+    record.piece_top = piece_pos.y + geometry.min_y;
+    record.piece_color = piece.getColorIndex();
+    record.piece_rows.fill(0);
+    for (int y = geometry.min_y; y <= geometry.max_y; ++y) {
+        record.piece_rows[y - geometry.min_y] = static_cast<RowMask>(static_cast<RowMask>(geometry.row_masks[y]) << left);
+    }
+    placeCells(piece);
+    
+    // The board had no full rows, so only rows the piece covers can be full now
+    record.lines_cleared = stats_.complete_lines;
+    record.cleared_rows = 0;
+    if (record.lines_cleared == 0) {
+        checkStats();
+        return true;
+    }
+    record.clear_top = HEIGHT - stats_.max_height;
+    int stored = 0;
+    for (int y = piece_pos.y + geometry.max_y; y >= record.piece_top; --y) {
+        if (rows_[y] == FULL_ROW) {
+            record.cleared_rows |= uint64_t{1} << y;
+            record.cleared_colors[stored++] = packColors(y);
+        }
+    }
+    removeFullRows(record.cleared_rows, record.lines_cleared);
+    return true;
+}
+
+template <int Width, int Height>
+void BasicBoard<Width, Height>::undo(const UndoRecord& record) {
+    if (record.cleared_rows != 0) {
+        // Reverse compactRows over the same span, top down: cleared rows come back
+        // from the record, surviving rows move back up from below (src never trails y)
+        const int lowest = highestSetBit(record.cleared_rows);
+        int src = record.clear_top + record.lines_cleared;
+        int stored = record.lines_cleared;
+        for (int y = record.clear_top; y <= lowest; ++y) {
+            if ((record.cleared_rows >> y) & 1) {
+                rows_[y] = FULL_ROW;
+                unpackColors(y, record.cleared_colors[--stored]);
+            } else {
+                grid_[y] = grid_[src];
+                rows_[y] = rows_[src];
+                ++src;
+            }
+        }
+    }
+    
+    // Lift the piece back out
+    for (int i = 0; i < static_cast<int>(record.piece_rows.size()) && record.piece_rows[i] != 0; ++i) {
+        const int y = record.piece_top + i;
+        for (RowMask cells = record.piece_rows[i]; cells != 0; cells &= cells - 1) {
+            grid_[y][countTrailingZeros(cells)].clear();
+        }
+        rows_[y] &= static_cast<RowMask>(~record.piece_rows[i]);
+    }
+    heights_ = record.heights;
+    stats_ = record.stats;
+    hash_ = record.hash;
+    filled_cells_ = record.filled_cells;
+    checkStats();
+}
+
+template <int Width, int Height>
+typename BasicBoard<Width, Height>::PackedColorRow BasicBoard<Width, Height>::packColors(int y) const noexcept {
+    PackedColorRow packed{};
+    for (int x = 0; x < WIDTH; ++x) {
+        packed[x / CELLS_PER_COLOR_WORD] |=
+            static_cast<ColorWord>(colorCode(grid_[y][x].color)) << (3 * (x % CELLS_PER_COLOR_WORD));
+    }
+    return packed;
+}
+
+template <int Width, int Height>
+void BasicBoard<Width, Height>::unpackColors(int y, const PackedColorRow& colors) noexcept {
+    for (int x = 0; x < WIDTH; ++x) {
+        const auto code = static_cast<uint8_t>((colors[x / CELLS_PER_COLOR_WORD] >> (3 * (x % CELLS_PER_COLOR_WORD))) & 7);
+        grid_[y][x] = Cell((rows_[y] >> x) & 1, codeColor(code));
+    }
+}
+
+template <int Width, int Height>
+typename BasicBoard<Width, Height>::Snapshot BasicBoard<Width, Height>::snapshot() const noexcept {
+    Snapshot snapshot;
+    snapshot.rows = rows_;
+    for (int y = HEIGHT - stats_.max_height; y < HEIGHT; ++y) {
+        snapshot.colors[y] = packColors(y); // Rows above the stack stay all-empty
+    }
+    return snapshot;
+}
+
+template <int Width, int Height>
+void BasicBoard<Width, Height>::restore(const Snapshot& snapshot) {
+    rows_ = snapshot.rows;
+    filled_cells_ = 0;
+    for (int y = 0; y < HEIGHT; ++y) {
+        unpackColors(y, snapshot.colors[y]);
+        filled_cells_ += popCount(rows_[y]);
+    }
+    
+    // Rebuild the derived state as after a clear, scanning the whole board
+    stats_.max_height = HEIGHT;
+    recomputeHeights();
+    stats_.complete_lines = countCompleteLines();
+    hash_ = computeHash();
+    checkStats();
+}
+
+template <int Width, int Height>
+bool BasicBoard<Width, Height>::isLineComplete(int line) const {
+    if (line < 0 || line >= HEIGHT) return false;
+    return rows_[line] == FULL_ROW;
+}
+
+template <int Width, int Height>
+void BasicBoard<Width, Height>::compactRows(uint64_t full_rows) noexcept {
+    // Rows below the lowest full row stay put and rows above the stack are empty.
+    // Going up from the lowest full row, the rows up to the next full row (or the top
+    // of the stack) move down as one block, by the number of full rows below them.
+    // Blocks lower down have already moved out of the way, so each moves once.
+    const int top = HEIGHT - stats_.max_height;
+    uint64_t hash = hash_;
+    uint64_t remaining = full_rows;
+    int shift = 0;
+    while (remaining != 0) {
+        const int line = highestSetBit(remaining);
+        remaining &= ~(uint64_t{1} << line);
+        ++shift;
+        const int begin = remaining != 0 ? highestSetBit(remaining) + 1 : top;
+
+        // The block's contributions all rotate by the same shift; the full row's is dropped
+        uint64_t moved = 0;
+        for (int y = begin; y < line; ++y) {
+            moved ^= rowContribution(y, rows_[y]);
+        }
+        hash ^= rowContribution(line, FULL_ROW) ^ moved ^ rotateRowKey(moved, shift);
+        std::copy_backward(grid_.begin() + begin, grid_.begin() + line, grid_.begin() + line + shift);
+        std::copy_backward(rows_.begin() + begin, rows_.begin() + line, rows_.begin() + line + shift);
+    }
+    // One vacated row per cleared line is left at the top of the stack
+    for (int y = top; y < top + shift; ++y) {
+        grid_[y].fill(Cell());
+        rows_[y] = 0;
+    }
+    hash_ = hash;
+}
+
+template <int Width, int Height>
+void BasicBoard<Width, Height>::clearOneRow(int line) noexcept {
+    // The most common clear. The rows move as in any clear, but the heights need no
+    // rescan of the stack
+    compactRows(uint64_t{1} << line);
+
+    // Every column had a cell in the line. Taller columns just lose a row; a column
+    // whose top cell was in the line falls to its highest cell below it
+    const int line_height = HEIGHT - line;
+    RowMask ended = 0;
+    for (int x = 0; x < WIDTH; ++x) {
+        if (heights_[x] > line_height) {
+            heights_[x]--;
+        } else {
+            heights_[x] = 0;
+            ended |= RowMask{1} << x;
+        }
+    }
+    for (int y = line + 1; y < HEIGHT && ended != 0; ++y) {
+        for (RowMask found = rows_[y] & ended; found != 0; found &= found - 1) {
+            heights_[countTrailingZeros(found)] = HEIGHT - y;
+        }
+        ended &= static_cast<RowMask>(~rows_[y]);
+    }
+    updateHeightStats();
+}
+
+template <int Width, int Height>
+bool BasicBoard<Width, Height>::isGameOver() const {
+    // Game is over if any cell in the top row (or just outside, in the spawn zone) is occupied.
+    return rows_[0] != 0;
+}
+
+template <int Width, int Height>
+void BasicBoard<Width, Height>::recomputeHeights() noexcept {
+    // Scan down from the top; the first row containing a column's bit sets its height.
+    // Heights only drop here, so rows above the previous maximum are still empty.
+    const int top = HEIGHT - stats_.max_height;
+    heights_.fill(0);
+    RowMask seen = 0;
+    for (int y = top; y < HEIGHT && seen != FULL_ROW; ++y) {
+        for (RowMask fresh = rows_[y] & ~seen; fresh != 0; fresh &= fresh - 1) {
+            heights_[countTrailingZeros(fresh)] = HEIGHT - y;
+        }
+        seen |= rows_[y];
+    }
+    
+    updateHeightStats();
+}
+
+template <int Width, int Height>
+void BasicBoard<Width, Height>::updateHeightStats() noexcept {
+    // Every column may have moved, so rebuild the height-derived metrics in one pass
+    stats_.total_height = 0;
+    stats_.max_height = 0;
+    stats_.bumpiness = 0;
+    for (int x = 0; x < WIDTH; ++x) {
+        stats_.total_height += heights_[x];
+        stats_.max_height = std::max(stats_.max_height, heights_[x]);
+        if (x > 0) {
+            stats_.bumpiness += std::abs(heights_[x - 1] - heights_[x]);
+        }
+    }
+    stats_.holes = stats_.total_height - filled_cells_;
+    stats_.complete_lines = 0; // Full rows were just removed (restore() recounts its own)
+}
+
+template <int Width, int Height>
+Position BasicBoard<Width, Height>::findDropPosition(const Tetromino& piece) const {
+    Position drop_pos = piece.getPosition();
+    if (canPlacePiece(piece)) {
+        // Distance to the surface in each column the piece covers; the smallest one wins
+        const auto& geometry = piece.getGeometry();
+        int distance = HEIGHT;
+        bool above_surface = true;
+        for (int x = geometry.min_x; x <= geometry.max_x; ++x) {
+            const int bottom = geometry.column_bottom[x];
+            if (bottom < 0) continue;
+            const int cell_y = drop_pos.y + bottom;
+            const int surface_y = HEIGHT - heights_[drop_pos.x + x];
+            if (cell_y >= surface_y) {
+                above_surface = false; // Tucked under an overhang in this column
+                break;
+            }
+            distance = std::min(distance, surface_y - 1 - cell_y);
+        }
+        if (above_surface) {
+            drop_pos.y += distance;
+            return drop_pos;
+        }
+    }
+    while (canPlacePiece(piece, {drop_pos.x, drop_pos.y + 1}, piece.getRotation())) {
+        drop_pos.y++;
+    }
+    return drop_pos;
+}
+
+template <int Width, int Height>
+int BasicBoard<Width, Height>::countCompleteLines() const {
+    int count = 0;
+    for (const RowMask row : rows_) {
+        count += row == FULL_ROW;
+    }
+    return count;
+}
+
+template <int Width, int Height>
+std::vector<int> BasicBoard<Width, Height>::getCompleteLines() const {
+    std::vector<int> lines;
+    for (int y = 0; y < HEIGHT; ++y) {
+        if (isLineComplete(y)) {
+            lines.push_back(y);
+        }
+    }
+    return lines;
+}
+
+template <int Width, int Height>
+int BasicBoard<Width, Height>::getColumnHeight(int column) const {
+    if (column < 0 || column >= WIDTH) return 0;
+    return heights_[column];
+}
+
+template <int Width, int Height>
+uint64_t BasicBoard<Width, Height>::computeHash() const noexcept {
+    uint64_t hash = 0;
+    for (int y = 0; y < HEIGHT; ++y) {
+        hash ^= rowContribution(y, rows_[y]);
+    }
+    return hash;
+}
+
+template <int Width, int Height>
+int BasicBoard<Width, Height>::scanColumnHeight(int column) const noexcept {
+    const RowMask bit = RowMask{1} << column;
+    for (int y = 0; y < HEIGHT; ++y) {
+        if (rows_[y] & bit) return HEIGHT - y;
+    }
+    return 0;
+}
+
+template <int Width, int Height>
+bool BasicBoard<Width, Height>::verifyStats() const {
+    for (int x = 0; x < WIDTH; ++x) {
+        if (heights_[x] != scanColumnHeight(x)) return false;
+    }
+    return stats_ == calculateStats();
+}
+
+template <int Width, int Height>
+BoardStats BasicBoard<Width, Height>::calculateStats() const {
+    BoardStats stats;
+    stats.complete_lines = countCompleteLines();
+    
+    // Scanned rather than read from heights_, so a drift in the maintained heights shows up here
+    std::array<int, WIDTH> heights;
+    for (int x = 0; x < WIDTH; ++x) {
+        heights[x] = scanColumnHeight(x);
+        stats.total_height += heights[x];
+        if (heights[x] > stats.max_height) {
+            stats.max_height = heights[x];
+        }
+        
+        // Calculate holes
+        for (int y = HEIGHT - heights[x]; y < HEIGHT; ++y) {
+            if (!(rows_[y] & (RowMask{1} << x))) {
+                stats.holes++;
+            }
+        }
+    }
+    
+    // Calculate bumpiness
+    for (int x = 0; x < WIDTH - 1; ++x) {
+        stats.bumpiness += std::abs(heights[x] - heights[x+1]);
+    }
+    
+    return stats;
+}
+
+} // namespace Tetris
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "Board.h"
+#include "Tetromino.h"
+#include <array>
+#include <cstdint>
+
+namespace Tetris {
+
+/**
+ * @brief What a board cell shows once the active piece and its ghost are overlaid
+ */
+enum class CellLayer : uint8_t {
+    EMPTY = 0,
+    LOCKED,     // Settled block on the board
+    ACTIVE,     // Part of the falling piece
+    GHOST       // Landing preview of the falling piece
+};
+
+/**
+ * @brief A single overlaid cell as seen by the renderer
+ */
+struct ViewCell {
+    CellLayer layer{CellLayer::EMPTY};
+    uint8_t color{0};   // Board color for LOCKED, piece color for ACTIVE and GHOST
+};
+
+/**
+ * @brief Occupancy of one board row split by layer (bit x = column x)
+ */
+struct RowLayers {
+    uint32_t locked{0};
+    uint32_t active{0};    // Active piece cells not on locked cells
+    uint32_t ghost{0};     // Ghost cells not covered by the active piece
+};
+
+/**
+ * @brief Read-only overlay of the active piece and its ghost on a board
+ *
+ * Holds a reference to the board plus the row masks of the active piece and
+ * its landing position, so per-cell queries cost a couple of mask tests and
+ * nothing is copied. Whole frames should be read with forEachCell(), which
+ * tests the piece masks once per row and reads rows the piece does not
+ * touch straight from the board. The view must not outlive the board it
+ * refers to.
+ */
+class BoardOverlayView {
+public:
+    /**
+     * @brief Build an overlay view for one frame
+     * @param board Board the piece falls on
+     * @param piece Active piece (NONE type shows the bare board)
+     * @param show_ghost Whether to overlay the landing preview
+     */
+    BoardOverlayView(const Board& board, const Tetromino& piece, bool show_ghost);
+
+    /**
+     * @brief Query the layer masks of a whole row
+     * @param y Y coordinate (must be in bounds)
+     * @return Locked, active and ghost masks for that row
+     */
+    [[nodiscard]] RowLayers rowAt(int y) const noexcept {
+        RowLayers row;
+        row.locked = board_.getRowMasks()[y];
+        row.active = maskAt(active_rows_, active_top_, y) & ~row.locked;
+        row.ghost = maskAt(ghost_rows_, ghost_top_, y) & ~(row.locked | row.active);
+        return row;
+    }
+
+    /**
+     * @brief Query a cell of the overlaid board
+     * @param x X coordinate (must be in bounds)
+     * @param y Y coordinate (must be in bounds)
+     * @return Layer and color shown at that cell
+     */
+    [[nodiscard]] ViewCell cellAt(int x, int y) const noexcept {
+        return cellIn(rowAt(y), x, y);
+    }
+
+    /**
+     * @brief Decode a cell from row masks already fetched with rowAt()
+     * @param row Layer masks of row y
+     * @param x X coordinate (must be in bounds)
+     * @param y Y coordinate of the row
+     * @return Layer and color shown at that cell
+     */
+    [[nodiscard]] ViewCell cellIn(const RowLayers& row, int x, int y) const noexcept {
+        // The three masks are disjoint and GHOST = LOCKED | ACTIVE as a code, so the
+        // layer is two bit tests; empty board cells have color 0, so the board
+        // color can be added unconditionally
+        const uint32_t low = ((row.locked | row.ghost) >> x) & 1;
+        const uint32_t piece = ((row.active | row.ghost) >> x) & 1;
+        ViewCell cell;
+        cell.layer = static_cast<CellLayer>(low | piece << 1);
+        cell.color = static_cast<uint8_t>(board_.getGrid()[y][x].color + (piece_color_ & (0u - piece)));
+        return cell;
+    }
+
+    /**
+     * @brief Visit every cell of one row of the overlaid board, left to right
+     * @param y Y coordinate (must be in bounds)
+     * @param fn Called as fn(x, const ViewCell&) for each column
+     */
+    template <typename Fn>
+    void forEachCell(int y, Fn&& fn) const {
+        const RowLayers row = rowAt(y);
+        const auto& board_row = board_.getGrid()[y];
+        if ((row.active | row.ghost) == 0) {
+            // Only the rows under the piece and its ghost need decoding; the rest are the board's cells
+            for (int x = 0; x < Board::WIDTH; ++x) {
+                fn(x, ViewCell{static_cast<CellLayer>(board_row[x].occupied), board_row[x].color});
+            }
+            return;
+        }
+        // Same result as cellIn(): piece cells never sit on locked cells, so every other cell is the board's
+        const ViewCell piece_cells[2] = {{CellLayer::ACTIVE, piece_color_}, {CellLayer::GHOST, piece_color_}};
+        const uint32_t overlay = row.active | row.ghost;
+        for (int x = 0; x < Board::WIDTH; ++x) {
+            if ((overlay >> x) & 1) {
+                fn(x, piece_cells[(row.ghost >> x) & 1]);
+            } else {
+                fn(x, ViewCell{static_cast<CellLayer>(board_row[x].occupied), board_row[x].color});
+            }
+        }
+    }
+
+    /**
+     * @brief Get the underlying board
+     * @return Const reference to the board
+     */
+    [[nodiscard]] const Board& getBoard() const noexcept { return board_; }
+
+    /**
+     * @brief Get the type of the overlaid piece
+     * @return Piece type (NONE if no piece is overlaid)
+     */
+    [[nodiscard]] TetrominoType getPieceType() const noexcept { return piece_type_; }
+
+    /**
+     * @brief Get where the ghost piece lands
+     * @return Landing position (equal to the piece position when the ghost is hidden)
+     */
+    [[nodiscard]] const Position& getGhostPosition() const noexcept { return ghost_pos_; }
+
+private:
+    using PieceRows = std::array<uint32_t, 4>;
+
+    const Board& board_;
+    TetrominoType piece_type_{TetrominoType::NONE};
+    uint8_t piece_color_{0};
+    Position ghost_pos_;
+    int active_top_{0};          // Board row of active_rows_[0]
+    int ghost_top_{0};           // Board row of ghost_rows_[0]
+    PieceRows active_rows_{};    // Active piece cells per row, already shifted to board columns
+    PieceRows ghost_rows_{};     // Ghost cells per row, already shifted to board columns
+
+    /**
+     * @brief Fill per-row board masks for a piece frame placed at a position
+     */
+    static void buildRows(const PieceGeometry& geometry, const Position& pos, PieceRows& rows, int& top) noexcept;
+
+    [[nodiscard]] static uint32_t maskAt(const PieceRows& rows, int top, int y) noexcept {
+        const unsigned index = static_cast<unsigned>(y - top);
+        return index < rows.size() ? rows[index] : 0;
+    }
+};
+
+} // namespace Tetris
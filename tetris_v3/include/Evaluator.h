@@ -0,0 +1,249 @@
+#pragma once
+
+#include "BitOps.h"
+#include "Board.h"
+#include "MoveGenerator.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <limits>
+#include <string>
+
+namespace Tetris {
+
+/**
+ * @brief Board features the evaluator weighs
+ */
+enum class Feature : uint8_t {
+    TOTAL_HEIGHT = 0,       // Sum of column heights
+    MAX_HEIGHT,             // Highest column
+    HOLES,                  // Empty cells below a column's top
+    BUMPINESS,              // Sum of height differences between neighbouring columns
+    LINES_CLEARED,          // Lines the placement cleared, plus any full rows still on the board
+    WELLS,                  // Cumulative well depth: a well d deep between higher neighbours adds 1 + 2 + ... + d
+    ROW_TRANSITIONS,        // Filled/empty changes along each row, walls counting as filled
+    COLUMN_TRANSITIONS,     // Filled/empty changes down each column, the floor counting as filled
+    COVERED_CELLS,          // Filled cells above the lowest hole of their column
+    HOLE_ROWS,              // Rows with at least one hole
+    COUNT
+};
+
+constexpr int FEATURE_COUNT = static_cast<int>(Feature::COUNT);
+
+/**
+ * @brief Feature names as written in weight files, in Feature order
+ */
+inline constexpr std::array<const char*, FEATURE_COUNT> FEATURE_NAMES = {
+    "total_height", "max_height", "holes", "bumpiness", "lines_cleared",
+    "wells", "row_transitions", "column_transitions", "covered_cells", "hole_rows"
+};
+
+/**
+ * @brief Feature values of one board
+ */
+struct BoardFeatures {
+    std::array<int, FEATURE_COUNT> values{};
+
+    [[nodiscard]] int operator[](Feature feature) const noexcept { return values[static_cast<size_t>(feature)]; }
+    int& operator[](Feature feature) noexcept { return values[static_cast<size_t>(feature)]; }
+};
+
+/**
+ * @brief Compute every feature of a board
+ *
+ * Heights, holes and bumpiness come straight from the board's maintained
+ * BoardStats. The rest is derived from the row masks over the rows of the
+ * stack only: transitions are popcounts of XORed (wall-padded) rows, holes
+ * per row are the columns already covered from above and not filled, and
+ * wells come from the column heights. Empty rows above the stack add their
+ * two wall transitions without being read.
+ *
+ * @param board Board to measure
+ * @param lines_cleared Lines the move being judged cleared (e.g. UndoRecord::lines_cleared)
+ * @return Feature values
+ */
+template <int Width, int Height>
+[[nodiscard]] BoardFeatures extractFeatures(const BasicBoard<Width, Height>& board, int lines_cleared = 0) noexcept {
+    using BoardType = BasicBoard<Width, Height>;
+    const BoardStats& stats = board.stats();
+    const auto& rows = board.getRowMasks();
+    const auto& heights = board.getColumnHeights();
+
+    BoardFeatures features;
+    features[Feature::TOTAL_HEIGHT] = stats.total_height;
+    features[Feature::MAX_HEIGHT] = stats.max_height;
+    features[Feature::HOLES] = stats.holes;
+    features[Feature::BUMPINESS] = stats.bumpiness;
+    features[Feature::LINES_CLEARED] = lines_cleared + stats.complete_lines;
+
+    const int top = Height - stats.max_height;
+    constexpr uint64_t FULL = BoardType::FULL_ROW;
+    // A row shifted up one bit with wall bits at both ends; bit i differs from bit i + 1 at each transition
+    constexpr uint64_t WALLS = 1 | (uint64_t{1} << (Width + 1));
+    constexpr uint64_t TRANSITION_BITS = (uint64_t{1} << (Width + 1)) - 1;
+    static_assert(Width + 2 <= 64, "padded rows must fit 64 bits");
+
+    int row_transitions = 2 * top;
+    int column_transitions = 0;
+    int hole_rows = 0;
+    int lowest_hole_row = -1;
+    uint64_t above = 0;     // Columns filled somewhere above the current row
+    uint64_t previous = 0;  // Row above the current one (empty above the stack)
+    std::array<uint64_t, Height> hole_masks;  // Only rows top..lowest_hole_row are written and read
+    for (int y = top; y < Height; ++y) {
+        const uint64_t row = rows[y];
+        const uint64_t padded = (row << 1) | WALLS;
+        row_transitions += popCount((padded ^ (padded >> 1)) & TRANSITION_BITS);
+        column_transitions += popCount(row ^ previous);
+        previous = row;
+
+        // Branch-free: whether a row has holes is unpredictable
+        hole_masks[y] = above & ~row;
+        hole_rows += hole_masks[y] != 0;
+        lowest_hole_row = hole_masks[y] ? y : lowest_hole_row;
+        above |= row;
+    }
+    column_transitions += popCount(FULL ^ previous);
+
+    // Bottom-up from the lowest hole: a filled cell is covering if its column has a hole further down
+    int covered = 0;
+    uint64_t holes_below = 0;
+    for (int y = lowest_hole_row; y >= top; --y) {
+        covered += popCount(rows[y] & holes_below);
+        holes_below |= hole_masks[y];
+    }
+
+    int wells = 0;
+    for (int x = 0; x < Width; ++x) {
+        const int left = x > 0 ? heights[x - 1] : Height;
+        const int right = x < Width - 1 ? heights[x + 1] : Height;
+        const int depth = std::max(0, std::min(left, right) - heights[x]);
+        wells += depth * (depth + 1) / 2;
+    }
+
+    features[Feature::WELLS] = wells;
+    features[Feature::ROW_TRANSITIONS] = row_transitions;
+    features[Feature::COLUMN_TRANSITIONS] = column_transitions;
+    features[Feature::COVERED_CELLS] = covered;
+    features[Feature::HOLE_ROWS] = hole_rows;
+    return features;
+}
+
+/**
+ * @brief Scores boards as a weighted sum of their features
+ *
+ * Higher is better. Weights are plain numbers per feature, so they can be
+ * tuned offline and stored in a weight file: one "name value" pair per
+ * line, names from FEATURE_NAMES, '#' starting a comment. Features a file
+ * does not list weigh 0.
+ */
+class Evaluator {
+public:
+    using Weights = std::array<double, FEATURE_COUNT>;
+
+    /**
+     * @brief Hand-set starting weights (a greedy one-piece bot clears thousands of lines with them)
+     * @return Default weights
+     */
+    [[nodiscard]] static Weights defaultWeights() noexcept;
+
+    Evaluator() : weights_(defaultWeights()) {}
+    explicit Evaluator(const Weights& weights) : weights_(weights) {}
+
+    /**
+     * @brief Score a board
+     * @param board Board after the move being judged
+     * @param lines_cleared Lines that move cleared
+     * @return Weighted feature sum
+     */
+    template <int Width, int Height>
+    [[nodiscard]] double evaluate(const BasicBoard<Width, Height>& board, int lines_cleared = 0) const noexcept {
+        return score(extractFeatures(board, lines_cleared));
+    }
+
+    /**
+     * @brief Weigh precomputed features
+     * @param features Feature values
+     * @return Weighted feature sum
+     */
+    [[nodiscard]] double score(const BoardFeatures& features) const noexcept {
+        double total = 0;
+        for (int i = 0; i < FEATURE_COUNT; ++i) {
+            total += weights_[i] * features.values[i];
+        }
+        return total;
+    }
+
+    [[nodiscard]] const Weights& getWeights() const noexcept { return weights_; }
+    [[nodiscard]] double getWeight(Feature feature) const noexcept { return weights_[static_cast<size_t>(feature)]; }
+    void setWeights(const Weights& weights) noexcept { weights_ = weights; }
+    void setWeight(Feature feature, double weight) noexcept { weights_[static_cast<size_t>(feature)] = weight; }
+
+    /**
+     * @brief Parse weights in the weight file format
+     * @param in Stream to read
+     * @param source Name used in error messages
+     * @return Parsed weights
+     * @throws std::runtime_error On an unknown or repeated feature or a malformed value
+     */
+    [[nodiscard]] static Weights parseWeights(std::istream& in, const std::string& source = "weights");
+
+    /**
+     * @brief Write weights in the weight file format (every feature, full precision)
+     * @param out Stream to write
+     * @param weights Weights to write
+     */
+    static void writeWeights(std::ostream& out, const Weights& weights);
+
+    /**
+     * @brief Read a weight file
+     * @param path File to read
+     * @return Parsed weights
+     * @throws std::runtime_error If the file cannot be read or parsed
+     */
+    [[nodiscard]] static Weights loadWeights(const std::string& path);
+
+    /**
+     * @brief Write a weight file
+     * @param path File to create or overwrite
+     * @param weights Weights to write
+     * @throws std::runtime_error If the file cannot be written
+     */
+    static void saveWeights(const std::string& path, const Weights& weights);
+
+private:
+    Weights weights_;
+};
+
+/**
+ * @brief Greedy one-piece choice: the generated placement whose resulting board scores best
+ *
+ * A placement that tops out ranks below every one that does not, so the
+ * choice tops out only when all of them do. The tuner's games, MCTS
+ * rollouts and the benches all pick moves this way.
+ * @param board Board the placements were generated on (left as it was)
+ * @param generator Placements from generate() on that board
+ * @param evaluator Scores the resulting boards
+ * @return Index of the best placement in generator (0 if it holds none)
+ */
+template <int Width, int Height>
+[[nodiscard]] int bestPlacement(BasicBoard<Width, Height>& board, const BasicMoveGenerator<Width, Height>& generator,
+                                const Evaluator& evaluator) {
+    int best = 0;
+    double best_score = -std::numeric_limits<double>::infinity();
+    typename BasicBoard<Width, Height>::UndoRecord record;
+    for (int i = 0; i < generator.size(); ++i) {
+        if (!board.applyPiece(generator.piece(generator[i]), record)) continue;
+        const double score = board.isGameOver() ? -std::numeric_limits<double>::max()
+                                                : evaluator.evaluate(board, record.lines_cleared);
+        board.undo(record);
+        if (score > best_score) {
+            best_score = score;
+            best = i;
+        }
+    }
+    return best;
+}
+
+} // namespace Tetris
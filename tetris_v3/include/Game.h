@@ -1,12 +1,16 @@
 #pragma once
 
+#include "AutoPlayer.h"
 #include "Board.h"
+#include "GameSimulation.h"
+#include "Replay.h"
 #include "Tetromino.h"
 #include "Input.h"
 #include "Renderer.h"
 #include <chrono>
-#include <random>
-#include <queue>
+#include <array>
+#include <optional>
+#include <string>
 #include <memory>
 #include <functional>
 
@@ -24,79 +28,19 @@ enum class GameState : uint8_t {
     EXITING
 };
 
-/**
- * @brief Game difficulty configuration
- */
-struct GameDifficulty {
-    std::chrono::milliseconds initial_drop_speed{1000};     // Starting drop speed
-    std::chrono::milliseconds min_drop_speed{50};           // Fastest possible drop speed
-    int lines_per_level{10};                                // Lines to clear per level
-    double speed_multiplier{0.9};                           // Speed increase factor per level
-    int max_level{20};                                      // Maximum level
-    
-    GameDifficulty() = default;
-    
-    /**
-     * @brief Calculate drop speed for a given level
-     * @param level Current game level
-     * @return Drop speed in milliseconds
-     */
-    [[nodiscard]] std::chrono::milliseconds getDropSpeed(int level) const {
-        auto speed = initial_drop_speed;
-        for (int i = 1; i < level && i <= max_level; ++i) {
-            speed = std::chrono::duration_cast<std::chrono::milliseconds>(
-                std::chrono::duration<double, std::milli>(speed.count() * speed_multiplier)
-            );
-        }
-        return std::max(speed, min_drop_speed);
-    }
-};
-
-/**
- * @brief Score calculation configuration
- */
-struct ScoreConfig {
-    int single_line{100};      // Points for clearing 1 line
-    int double_line{300};      // Points for clearing 2 lines
-    int triple_line{500};      // Points for clearing 3 lines
-    int tetris_line{800};      // Points for clearing 4 lines (Tetris)
-    int soft_drop{1};          // Points per cell for soft drop
-    int hard_drop{2};          // Points per cell for hard drop
-    int level_multiplier{1};   // Multiply base score by level
-    
-    ScoreConfig() = default;
-    
-    /**
-     * @brief Calculate score for line clears
-     * @param lines_cleared Number of lines cleared
-     * @param level Current level
-     * @return Score points earned
-     */
-    [[nodiscard]] int calculateLineScore(int lines_cleared, int level) const {
-        int base_score = 0;
-        switch (lines_cleared) {
-            case 1: base_score = single_line; break;
-            case 2: base_score = double_line; break;
-            case 3: base_score = triple_line; break;
-            case 4: base_score = tetris_line; break;
-            default: break;
-        }
-        return base_score * (level * level_multiplier + 1);
-    }
-};
-
 /**
  * @brief Main Tetris game controller
  * 
- * This class manages the complete game state, including the game loop,
- * piece generation, scoring, level progression, and user interface.
- * Designed for high performance with efficient timing and input handling.
+ * This class runs the interactive game: terminal input, rendering, menus
+ * and the 60 FPS frame loop. The rules (pieces, scoring, levels, gravity)
+ * live in the GameSimulation it drives, one tick per elapsed TICK_DURATION
+ * of wall time.
  */
 class TetrisGame {
 public:
     using GameOverCallback = std::function<void(int final_score, int final_level)>;
-    using LevelUpCallback = std::function<void(int new_level)>;
-    using ScoreUpdateCallback = std::function<void(int new_score, int lines_cleared)>;
+    using LevelUpCallback = GameSimulation::LevelUpCallback;
+    using ScoreUpdateCallback = GameSimulation::ScoreUpdateCallback;
     
     /**
      * @brief Game configuration structure
@@ -110,8 +54,25 @@ public:
         bool enable_ghost_piece{true};       // Show ghost piece preview
         bool enable_7_bag{true};             // Use 7-bag piece generation
         int next_piece_preview_count{1};     // Number of next pieces to show
+        std::optional<uint64_t> seed;        // Piece sequence seed for every game (unset = fresh random seed)
+        std::string record_path;             // Save each game's replay here when it ends (empty = off)
+        bool autoplay{false};                // Let the AutoPlayer play instead of the keyboard
+        AutoPlayer::Config autoplay_config;  // Search settings when autoplay is on
         
         Config() = default;
+        
+        /**
+         * @brief Rules part of the configuration
+         * @return Configuration for the GameSimulation
+         */
+        [[nodiscard]] GameSimulation::Config simulationConfig() const {
+            GameSimulation::Config sim;
+            sim.difficulty = difficulty;
+            sim.score_config = score_config;
+            sim.enable_hold = enable_hold;
+            sim.enable_7_bag = enable_7_bag;
+            return sim;
+        }
     };
     
     /**
@@ -148,6 +109,13 @@ public:
      */
     int run();
     
+    /**
+     * @brief Show a recorded game in real time (one tick per frame; ESC stops early)
+     * @param replay Recording to play
+     * @return Exit code (0 = normal exit, 1 = terminal setup failed)
+     */
+    int playReplay(const Replay& replay);
+    
     /**
      * @brief Shutdown game and cleanup resources
      */
@@ -191,49 +159,61 @@ public:
      * @brief Get current score
      * @return Current game score
      */
-    [[nodiscard]] int getScore() const noexcept { return score_; }
+    [[nodiscard]] int getScore() const noexcept { return simulation_.getScore(); }
     
     /**
      * @brief Get current level
      * @return Current game level
      */
-    [[nodiscard]] int getLevel() const noexcept { return level_; }
+    [[nodiscard]] int getLevel() const noexcept { return simulation_.getLevel(); }
     
     /**
      * @brief Get total lines cleared
      * @return Total lines cleared this game
      */
-    [[nodiscard]] int getLinesCleared() const noexcept { return total_lines_cleared_; }
+    [[nodiscard]] int getLinesCleared() const noexcept { return simulation_.getLinesCleared(); }
     
     /**
      * @brief Get current falling piece
      * @return Reference to current Tetromino
      */
-    [[nodiscard]] const Tetromino& getCurrentPiece() const noexcept { return current_piece_; }
+    [[nodiscard]] const Tetromino& getCurrentPiece() const noexcept { return simulation_.getCurrentPiece(); }
     
     /**
      * @brief Get next piece
      * @return Reference to next Tetromino
      */
-    [[nodiscard]] const Tetromino& getNextPiece() const noexcept { return next_piece_; }
+    [[nodiscard]] const Tetromino& getNextPiece() const noexcept { return simulation_.getNextPiece(); }
     
     /**
      * @brief Get held piece
      * @return Reference to held Tetromino
      */
-    [[nodiscard]] const Tetromino& getHeldPiece() const noexcept { return held_piece_; }
+    [[nodiscard]] const Tetromino& getHeldPiece() const noexcept { return simulation_.getHeldPiece(); }
     
     /**
      * @brief Check if hold action is available
      * @return True if player can hold current piece
      */
-    [[nodiscard]] bool canHold() const noexcept { return can_hold_; }
+    [[nodiscard]] bool canHold() const noexcept { return simulation_.canHold(); }
     
     /**
      * @brief Get game board
      * @return Reference to game Board
      */
-    [[nodiscard]] const Board& getBoard() const noexcept { return board_; }
+    [[nodiscard]] const Board& getBoard() const noexcept { return simulation_.getBoard(); }
+    
+    /**
+     * @brief Get the simulation the game drives
+     * @return Reference to the headless rules engine
+     */
+    [[nodiscard]] const GameSimulation& getSimulation() const noexcept { return simulation_; }
+    
+    /**
+     * @brief Get the recording of the current (or last) game
+     * @return Seed and effective inputs so far
+     */
+    [[nodiscard]] const Replay& getReplay() const noexcept { return recording_; }
     
     /**
      * @brief Set game over callback
@@ -245,19 +225,23 @@ public:
      * @brief Set level up callback
      * @param callback Function to call on level up
      */
-    void setLevelUpCallback(const LevelUpCallback& callback) { level_up_callback_ = callback; }
+    void setLevelUpCallback(const LevelUpCallback& callback) { simulation_.setLevelUpCallback(callback); }
     
     /**
      * @brief Set score update callback
      * @param callback Function to call on score change
      */
-    void setScoreUpdateCallback(const ScoreUpdateCallback& callback) { score_update_callback_ = callback; }
+    void setScoreUpdateCallback(const ScoreUpdateCallback& callback) { simulation_.setScoreUpdateCallback(callback); }
     
     /**
      * @brief Update game configuration
      * @param config New configuration
      */
-    void setConfig(const Config& config) { config_ = config; }
+    void setConfig(const Config& config) {
+        config_ = config;
+        simulation_.setConfig(config_.simulationConfig());
+        autoplayer_ = config_.autoplay ? std::make_unique<AutoPlayer>(config_.autoplay_config) : nullptr;
+    }
     
     /**
      * @brief Get current game configuration
@@ -295,40 +279,26 @@ private:
     GameState state_{GameState::MENU};
     
     // Game systems
-    Board board_;
+    GameSimulation simulation_;
     InputSystem input_system_;
     RenderSystem render_system_;
     
-    // Game state
-    Tetromino current_piece_;
-    Tetromino next_piece_;
-    Tetromino held_piece_;
-    bool can_hold_{true};
-    
-    // Scoring and progression
-    int score_{0};
-    int level_{1};
-    int total_lines_cleared_{0};
-    int lines_cleared_this_level_{0};
-    
     // Timing
-    std::chrono::steady_clock::time_point last_drop_time_;
-    std::chrono::steady_clock::time_point last_input_time_;
     std::chrono::steady_clock::time_point game_start_time_;
-    std::chrono::milliseconds current_drop_speed_;
-    
-    // Piece generation
-    std::mt19937 rng_;
-    std::queue<TetrominoType> piece_bag_;
-    int total_pieces_generated_{0};
+    std::chrono::milliseconds tick_backlog_{0};      // Wall time not yet simulated
     
     // Statistics
     DetailedStats stats_;
     
     // Callbacks
     GameOverCallback game_over_callback_;
-    LevelUpCallback level_up_callback_;
-    ScoreUpdateCallback score_update_callback_;
+    
+    // Recording of the current game
+    Replay recording_;
+    bool recording_open_{false};
+    
+    // Computer player standing in for the keyboard (null unless autoplay is on)
+    std::unique_ptr<AutoPlayer> autoplayer_;
     
     /**
      * @brief Update game logic for one frame
@@ -347,12 +317,6 @@ private:
      */
     void handleInput(const InputState& input);
     
-    /**
-     * @brief Process game logic when playing
-     * @param delta_time Time elapsed since last update
-     */
-    void updateGameplay(std::chrono::milliseconds delta_time);
-    
     /**
      * @brief Handle menu navigation
      * @param input Current input state
@@ -372,89 +336,14 @@ private:
     void handleGameOverInput(const InputState& input);
     
     /**
-     * @brief Move current piece if possible
-     * @param direction Movement direction
-     * @return True if move was successful
-     */
-    bool movePiece(const Position& direction);
-    
-    /**
-     * @brief Rotate current piece if possible
-     * @param clockwise True for clockwise rotation
-     * @return True if rotation was successful
-     */
-    bool rotatePiece(bool clockwise);
-    
-    /**
-     * @brief Perform hard drop of current piece
-     * @return Number of cells dropped
-     */
-    int hardDropPiece();
-    
-    /**
-     * @brief Perform soft drop of current piece
-     * @return True if piece moved down
-     */
-    bool softDropPiece();
-    
-    /**
-     * @brief Hold current piece (swap with held piece)
-     * @return True if hold was successful
-     */
-    bool holdPiece();
-    
-    /**
-     * @brief Lock current piece to board and spawn next piece
-     */
-    void lockPiece();
-    
-    /**
-     * @brief Spawn next piece as current piece
-     * @return True if spawn was successful (false = game over)
-     */
-    bool spawnNextPiece();
-    
-    /**
-     * @brief Generate next piece using 7-bag or random algorithm
-     */
-    void generateNextPiece();
-    
-    /**
-     * @brief Fill piece bag with randomized sequence
-     */
-    void fillPieceBag();
-    
-    /**
-     * @brief Update score based on lines cleared
-     * @param lines_cleared Number of lines cleared
-     */
-    void updateScore(int lines_cleared);
-    
-    /**
-     * @brief Update level based on lines cleared
-     */
-    void updateLevel();
-    
-    /**
-     * @brief Update drop speed based on current level
-     */
-    void updateDropSpeed();
-    
-    /**
-     * @brief Check if it's time for automatic piece drop
-     * @return True if piece should drop
-     */
-    [[nodiscard]] bool shouldDropPiece() const;
-    
-    /**
-     * @brief Reset game state for new game
+     * @brief Update game statistics
      */
-    void resetGameState();
+    void updateStats();
     
     /**
-     * @brief Update game statistics
+     * @brief Close the current game's recording and save it if a record path is set
      */
-    void updateStats();
+    void finishRecording();
     
     /**
      * @brief Get GameStats structure for rendering
@@ -462,17 +351,6 @@ private:
      */
     [[nodiscard]] GameStats getGameStatsForRender() const;
     
-    /**
-     * @brief Check and handle game over condition
-     * @return True if game is over
-     */
-    bool checkGameOver();
-    
-    /**
-     * @brief Initialize random number generator
-     */
-    void initializeRNG();
-    
     /**
      * @brief Get frame time target for smooth gameplay
      * @return Target frame duration
@@ -0,0 +1,357 @@
+#pragma once
+
+#include "Board.h"
+#include "Input.h"
+#include "Random.h"
+#include "Tetromino.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace Tetris {
+
+/**
+ * @brief Game difficulty configuration
+ */
+struct GameDifficulty {
+    std::chrono::milliseconds initial_drop_speed{1000};     // Starting drop speed
+    std::chrono::milliseconds min_drop_speed{50};           // Fastest possible drop speed
+    int lines_per_level{10};                                // Lines to clear per level
+    double speed_multiplier{0.9};                           // Speed increase factor per level
+    int max_level{20};                                      // Maximum level
+
+    GameDifficulty() = default;
+
+    /**
+     * @brief Calculate drop speed for a given level
+     * @param level Current game level
+     * @return Drop speed in milliseconds
+     */
+    [[nodiscard]] std::chrono::milliseconds getDropSpeed(int level) const {
+        auto speed = initial_drop_speed;
+        for (int i = 1; i < level && i <= max_level; ++i) {
+            speed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::duration<double, std::milli>(speed.count() * speed_multiplier)
+            );
+        }
+        return std::max(speed, min_drop_speed);
+    }
+};
+
+/**
+ * @brief Score calculation configuration
+ */
+struct ScoreConfig {
+    int single_line{100};      // Points for clearing 1 line
+    int double_line{300};      // Points for clearing 2 lines
+    int triple_line{500};      // Points for clearing 3 lines
+    int tetris_line{800};      // Points for clearing 4 lines (Tetris)
+    int soft_drop{1};          // Points per cell for soft drop
+    int hard_drop{2};          // Points per cell for hard drop
+    int level_multiplier{1};   // Multiply base score by level
+
+    ScoreConfig() = default;
+
+    /**
+     * @brief Calculate score for line clears
+     * @param lines_cleared Number of lines cleared
+     * @param level Current level
+     * @return Score points earned
+     */
+    [[nodiscard]] int calculateLineScore(int lines_cleared, int level) const {
+        int base_score = 0;
+        switch (lines_cleared) {
+            case 1: base_score = single_line; break;
+            case 2: base_score = double_line; break;
+            case 3: base_score = triple_line; break;
+            case 4: base_score = tetris_line; break;
+            default: break;
+        }
+        return base_score * (level * level_multiplier + 1);
+    }
+};
+
+/**
+ * @brief Headless Tetris rules engine advanced by explicit ticks
+ *
+ * Owns the board, the falling/next/held pieces, piece generation, scoring
+ * and level progression, and nothing else: no terminal, no sleeps and no
+ * clock reads. Gravity counts ticks (TICK_DURATION each), so a game plays
+ * identically whether ticks are driven by a 60 FPS frame loop or as fast as
+ * the CPU allows, and two simulations given the same seed and the same
+ * actions on the same ticks produce the same game. Pieces come from a
+ * Pcg32, so a seed deals the same sequence on every compiler and platform.
+ * TetrisGame wraps one for interactive play.
+ */
+class GameSimulation {
+public:
+    using LevelUpCallback = std::function<void(int new_level)>;
+    using ScoreUpdateCallback = std::function<void(int new_score, int lines_cleared)>;
+
+    /**
+     * @brief Simulated time per tick (one frame at ~60 FPS)
+     */
+    static constexpr std::chrono::milliseconds TICK_DURATION{16};
+
+    /**
+     * @brief Rules configuration
+     */
+    struct Config {
+        GameDifficulty difficulty;
+        ScoreConfig score_config;
+        bool enable_hold{true};              // Allow piece holding
+        bool enable_7_bag{true};             // Use 7-bag piece generation
+
+        Config() = default;
+    };
+
+    /**
+     * @brief Per-game counters
+     */
+    struct Counters {
+        int total_pieces{0};               // Pieces spawned
+        std::array<int, PIECE_TYPE_COUNT> piece_counts{}; // Pieces spawned per type
+        int tetris_count{0};               // Number of 4-line clears
+        uint64_t ticks{0};                 // Ticks simulated
+    };
+
+    /**
+     * @brief Construct a simulation with default rules
+     */
+    GameSimulation();
+
+    /**
+     * @brief Construct a simulation with custom rules
+     * @param config Rules configuration
+     */
+    explicit GameSimulation(const Config& config);
+
+    /**
+     * @brief Clear the board and start a new game
+     * @param seed Seed for piece generation (equal seeds deal equal piece sequences)
+     */
+    void newGame(uint64_t seed);
+
+    /**
+     * @brief Apply one player action to the falling piece
+     *
+     * Handles movement, rotation, soft and hard drop, and hold. Other
+     * actions (pause, quit, menu navigation) belong to the front end and are
+     * ignored, as is everything once the game is over.
+     *
+     * @param action Action to apply
+     * @return True if the action changed the game
+     */
+    bool applyAction(InputAction action);
+
+    /**
+     * @brief Advance one tick: count down gravity and drop or lock the piece when it expires
+     */
+    void tick();
+
+    /**
+     * @brief Apply an action and then advance one tick
+     * @param action Action for this tick (InputAction::NONE for none)
+     */
+    void step(InputAction action) {
+        applyAction(action);
+        tick();
+    }
+
+    /**
+     * @brief Check if the game has ended (spawn blocked or top row filled)
+     * @return True if game over
+     */
+    [[nodiscard]] bool isGameOver() const noexcept { return game_over_; }
+
+    /**
+     * @brief Get current score
+     * @return Current game score
+     */
+    [[nodiscard]] int getScore() const noexcept { return score_; }
+
+    /**
+     * @brief Get current level
+     * @return Current game level
+     */
+    [[nodiscard]] int getLevel() const noexcept { return level_; }
+
+    /**
+     * @brief Get total lines cleared
+     * @return Total lines cleared this game
+     */
+    [[nodiscard]] int getLinesCleared() const noexcept { return total_lines_cleared_; }
+
+    /**
+     * @brief Get current falling piece
+     * @return Reference to current Tetromino
+     */
+    [[nodiscard]] const Tetromino& getCurrentPiece() const noexcept { return current_piece_; }
+
+    /**
+     * @brief Get next piece
+     * @return Reference to next Tetromino
+     */
+    [[nodiscard]] const Tetromino& getNextPiece() const noexcept { return next_piece_; }
+
+    /**
+     * @brief Get held piece
+     * @return Reference to held Tetromino
+     */
+    [[nodiscard]] const Tetromino& getHeldPiece() const noexcept { return held_piece_; }
+
+    /**
+     * @brief Check if hold action is available
+     * @return True if player can hold current piece
+     */
+    [[nodiscard]] bool canHold() const noexcept { return can_hold_; }
+
+    /**
+     * @brief Get game board
+     * @return Reference to game Board
+     */
+    [[nodiscard]] const Board& getBoard() const noexcept { return board_; }
+
+    /**
+     * @brief Get the per-game counters
+     * @return Pieces, tetrises and ticks so far
+     */
+    [[nodiscard]] const Counters& getCounters() const noexcept { return counters_; }
+
+    /**
+     * @brief Get the seed the current game was started with
+     * @return Seed passed to newGame()
+     */
+    [[nodiscard]] uint64_t getSeed() const noexcept { return seed_; }
+
+    /**
+     * @brief Get the number of ticks between automatic drops at the current level
+     * @return Gravity interval in ticks (at least 1)
+     */
+    [[nodiscard]] int getGravityTicks() const noexcept { return gravity_ticks_; }
+
+    /**
+     * @brief Get the rules configuration
+     * @return Current configuration
+     */
+    [[nodiscard]] const Config& getConfig() const noexcept { return config_; }
+
+    /**
+     * @brief Replace the rules configuration (takes effect from the next game)
+     * @param config New configuration
+     */
+    void setConfig(const Config& config) { config_ = config; }
+
+    /**
+     * @brief Set level up callback
+     * @param callback Function to call on level up
+     */
+    void setLevelUpCallback(const LevelUpCallback& callback) { level_up_callback_ = callback; }
+
+    /**
+     * @brief Set score update callback
+     * @param callback Function to call on score change
+     */
+    void setScoreUpdateCallback(const ScoreUpdateCallback& callback) { score_update_callback_ = callback; }
+
+private:
+    Config config_;
+    Board board_;
+
+    // Pieces
+    Tetromino current_piece_;
+    Tetromino next_piece_;
+    Tetromino held_piece_;
+    bool can_hold_{true};
+    bool game_over_{false};
+
+    // Scoring and progression
+    int score_{0};
+    int level_{1};
+    int total_lines_cleared_{0};
+
+    // Gravity, in ticks
+    int gravity_ticks_{1};
+    int ticks_since_drop_{0};
+
+    // Piece generation
+    uint64_t seed_{0};
+    Pcg32 rng_;
+    std::array<TetrominoType, PIECE_TYPE_COUNT> piece_bag_{}; // Current shuffled 7-bag
+    size_t bag_index_{PIECE_TYPE_COUNT};                       // Next bag slot to deal (7 = bag empty)
+
+    Counters counters_;
+
+    // Callbacks
+    LevelUpCallback level_up_callback_;
+    ScoreUpdateCallback score_update_callback_;
+
+    /**
+     * @brief Move current piece if possible
+     * @param direction Movement direction
+     * @return True if move was successful
+     */
+    bool movePiece(const Position& direction);
+
+    /**
+     * @brief Rotate current piece if possible
+     * @param clockwise True for clockwise rotation
+     * @return True if rotation was successful
+     */
+    bool rotatePiece(bool clockwise);
+
+    /**
+     * @brief Perform hard drop of current piece
+     * @return Number of cells dropped
+     */
+    int hardDropPiece();
+
+    /**
+     * @brief Perform soft drop of current piece
+     * @return True if piece moved down
+     */
+    bool softDropPiece();
+
+    /**
+     * @brief Hold current piece (swap with held piece)
+     * @return True if hold was successful
+     */
+    bool holdPiece();
+
+    /**
+     * @brief Lock current piece to board, score cleared lines and spawn next piece
+     */
+    void lockPiece();
+
+    /**
+     * @brief Spawn next piece as current piece
+     * @return True if spawn was successful (false = game over)
+     */
+    bool spawnNextPiece();
+
+    /**
+     * @brief Generate next piece using 7-bag or uniform random choice
+     */
+    void generateNextPiece();
+
+    /**
+     * @brief Fill piece bag with randomized sequence
+     */
+    void fillPieceBag();
+
+    /**
+     * @brief Add points and notify the score callback
+     * @param points Points to add
+     * @param lines_cleared Lines cleared by the move that scored
+     */
+    void addScore(int points, int lines_cleared);
+
+    /**
+     * @brief Update level and gravity based on lines cleared
+     */
+    void updateLevel();
+};
+
+} // namespace Tetris
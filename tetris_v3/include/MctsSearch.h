@@ -0,0 +1,189 @@
+#pragma once
+
+#include "Board.h"
+#include "Evaluator.h"
+#include "GameSimulation.h"
+#include "MoveGenerator.h"
+#include "PieceQueue.h"
+#include "Random.h"
+#include "ThreadPool.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Tetris {
+
+/**
+ * @brief Monte Carlo tree search for the falling piece's placement
+ *
+ * The tree covers the known pieces (current, next and held, with the same
+ * hold choices as the beam search); its edges are MoveGenerator
+ * placements. Each simulation walks down by UCT to the first node not yet
+ * expanded, expands it (children ordered by their static evaluation, so
+ * the promising ones are tried first) and plays a rollout from the child
+ * it selects next, on the worker's own Board: the known pieces still
+ * unplaced, then rollout_depth pieces drawn at random, each placed
+ * greedily by the Evaluator. The rollout's value is the
+ * evaluation of its final board counting every line cleared on the way,
+ * or LOST_VALUE if it topped out.
+ *
+ * All threads of the ThreadPool search one shared tree (tree
+ * parallelisation). Visit counts and value sums are atomics; a thread
+ * adds a virtual loss to every node on its path while its rollout runs,
+ * which steers the other threads to different branches, and takes it back
+ * when it backs up the real value. Nodes are expanded by whichever thread
+ * gets there first; others roll out from the node meanwhile. Nodes come
+ * from a pool allocated once, so a search does not allocate.
+ *
+ * The placement with the most root visits is chosen. With one thread and
+ * max_rollouts set, a search is deterministic.
+ */
+class MctsSearch {
+public:
+    /**
+     * @brief Search settings
+     */
+    struct Config {
+        int rollout_depth{3};                   // Random pieces played past the known ones
+        double exploration{8.0};                // UCT exploration constant, in evaluator score units
+        double virtual_loss{20.0};              // Value taken off a node while a rollout through it runs
+        int max_nodes{1 << 17};                 // Tree node pool size
+        uint64_t max_rollouts{0};               // Stop after this many rollouts (0 = at the deadline only)
+        uint64_t seed{0};                       // Seed for rollout pieces
+
+        Config() = default;
+    };
+
+    /**
+     * @brief Chosen move and search totals
+     */
+    struct Result {
+        bool hold{false};                       // Hold first, then place the piece that comes out
+        TetrominoType piece{TetrominoType::NONE};
+        Position position;
+        Rotation rotation{Rotation::NORTH};
+        int visits{0};                          // Root visits of the chosen move
+        double value{0.0};                      // Its mean rollout value
+        uint64_t rollouts{0};                   // Rollouts this search
+        int nodes{0};                           // Tree nodes used
+    };
+
+    /**
+     * @brief Value of a rollout that tops out
+     */
+    static constexpr double LOST_VALUE = -1000.0;
+
+    /**
+     * @brief Construct a search
+     * @param config Search settings
+     * @param evaluator Scores rollout boards and orders children
+     * @param pool Threads to search with (one tree shared by all)
+     * @throws std::invalid_argument If max_nodes is less than 2 or rollout_depth is negative
+     */
+    MctsSearch(const Config& config, const Evaluator& evaluator, ThreadPool& pool);
+    ~MctsSearch();
+
+    MctsSearch(const MctsSearch&) = delete;
+    MctsSearch& operator=(const MctsSearch&) = delete;
+
+    /**
+     * @brief Search for the current piece's move
+     * @param simulation Game to search (read only)
+     * @param deadline Stop starting rollouts at this time (at least one always runs)
+     * @param use_hold Consider holding (if the game allows it)
+     * @return Most visited move (piece NONE if the current piece cannot be placed)
+     */
+    [[nodiscard]] Result search(const GameSimulation& simulation, std::chrono::steady_clock::time_point deadline,
+                                bool use_hold = true);
+
+    [[nodiscard]] const Config& getConfig() const noexcept { return config_; }
+
+private:
+    enum : int { UNEXPANDED = 0, EXPANDING, EXPANDED };
+
+    // Values are summed as fixed-point integers so they can be atomics
+    static constexpr double VALUE_SCALE = 1024.0;
+    static constexpr int MAX_PATH = 8;
+
+    struct Node {
+        std::atomic<int> visits{0};
+        std::atomic<int64_t> value{0};          // Sum of values (times VALUE_SCALE), virtual losses included
+        std::atomic<int> state{UNEXPANDED};
+        int first_child{0};
+        int child_count{0};
+        Placement placement;                    // Move into this node
+        TetrominoType piece{TetrominoType::NONE};
+        TetrominoType hold{TetrominoType::NONE};
+        int next{0};                            // Queue index of the first unplaced piece
+        int lines{0};                           // Lines cleared from the root to here
+        bool held{false};
+        bool lost{false};                       // The move topped out
+    };
+
+    struct Child {
+        double score;                           // Static evaluation, for ordering
+        int order;                              // Generation order (tie-break)
+        Placement placement;
+        PieceChoice choice;
+        int lines;
+        bool lost;
+    };
+
+    struct Worker {
+        std::unique_ptr<MoveGenerator> generator;
+        Board board;                            // Board along the current path
+        Board rollout;
+        Pcg32 rng;
+        std::vector<Child> children;
+        std::array<int, MAX_PATH> path{};
+    };
+
+    Config config_;
+    Evaluator evaluator_;
+    ThreadPool& pool_;
+    std::vector<Worker> workers_;
+    std::unique_ptr<Node[]> nodes_;
+    std::atomic<int> node_count_{0};
+    std::atomic<uint64_t> rollouts_{0};
+    std::atomic<bool> stop_{false};
+
+    // Root position of the running search
+    Board root_board_;
+    Tetromino root_piece_;
+    PieceQueue queue_;
+    bool root_hold_{false};
+    bool use_hold_{true};
+    uint64_t searches_{0};
+
+    /**
+     * @brief Run simulations on one worker until the deadline or the rollout limit
+     */
+    void simulate(int worker, std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief Create a node's children; worker.board must hold the node's position
+     * @return True if children were created
+     */
+    bool expand(Node& node, int index, Worker& worker);
+
+    /**
+     * @brief Play random pieces greedily from worker.board
+     * @return Rollout value
+     */
+    double rollout(const Node& node, Worker& worker);
+
+    /**
+     * @brief Pick a child by UCT
+     * @return Node index of the child
+     */
+    [[nodiscard]] int select(const Node& node) const noexcept;
+
+    void addValue(Node& node, double value) noexcept {
+        node.value.fetch_add(static_cast<int64_t>(value * VALUE_SCALE), std::memory_order_relaxed);
+    }
+};
+
+} // namespace Tetris
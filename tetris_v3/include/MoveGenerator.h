@@ -0,0 +1,324 @@
+#pragma once
+
+#include "BitOps.h"
+#include "Board.h"
+#include "Input.h"
+#include "PieceTable.h"
+#include "Tetromino.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Tetris {
+
+/**
+ * @brief A reachable lock position of the falling piece
+ */
+struct Placement {
+    Position position;                         // Frame position the piece locks at
+    Rotation rotation{Rotation::NORTH};
+    uint16_t state{0};                         // Search state index, used to rebuild the input path
+};
+
+/**
+ * @brief Enumerates every distinct position a piece can lock at
+ *
+ * Runs a breadth-first search over (x, y, rotation) states from the piece's
+ * current position, using exactly the game's moves: shift left/right, soft
+ * drop one row, and rotate either way with the same kick order as
+ * Board::findRotationPosition. Kicked rotations, tucks under overhangs and
+ * spins are therefore all found. A state locks when the row below it
+ * collides; lock states covering the same cells (symmetric rotations of I,
+ * O, S and Z) are reported once.
+ *
+ * Collision is not tested per state. Each search first builds, for every
+ * rotation and frame row, a mask of the frame columns where the piece
+ * would collide (board rows padded with wall bits, shifted once per piece
+ * cell), so every move the search tries is a single bit test.
+ *
+ * All storage is fixed-size and owned by the generator, so generate() never
+ * allocates. Results stay valid until the next generate() call; recursive
+ * searches keep one generator per ply.
+ *
+ * @tparam Width Board width in cells
+ * @tparam Height Board height in cells
+ */
+template <int Width, int Height>
+class BasicMoveGenerator {
+public:
+    using BoardType = BasicBoard<Width, Height>;
+
+    // A frame may hang up to 3 cells off the left and top edges
+    static constexpr int FRAME_MARGIN = 3;
+    static constexpr int SPAN_X = Width + FRAME_MARGIN;
+    static constexpr int SPAN_Y = Height + FRAME_MARGIN;
+    static constexpr int STATE_COUNT = SPAN_X * SPAN_Y * ROTATION_COUNT;
+    static_assert(STATE_COUNT < 0xFFFF, "state indices must fit 16 bits");
+    static_assert(Width + 2 * FRAME_MARGIN <= 64, "padded rows must fit 64 bits");
+
+    /**
+     * @brief Input sequence that takes the piece from its start to a placement
+     */
+    struct Path {
+        std::array<InputAction, STATE_COUNT + 1> actions{};
+        int length{0};
+    };
+
+    /**
+     * @brief Find every lock position of a piece on a board
+     * @param board Board to search
+     * @param piece Falling piece at its current position and rotation
+     * @return Number of distinct placements (0 if the piece does not fit where it is)
+     */
+    int generate(const BoardType& board, const Tetromino& piece) noexcept;
+
+    [[nodiscard]] int size() const noexcept { return count_; }
+    [[nodiscard]] const Placement* begin() const noexcept { return placements_.data(); }
+    [[nodiscard]] const Placement* end() const noexcept { return placements_.data() + count_; }
+    [[nodiscard]] const Placement& operator[](int index) const noexcept { return placements_[index]; }
+
+    /**
+     * @brief Number of (x, y, rotation) states the last search visited
+     * @return States reached from the start position
+     */
+    [[nodiscard]] int visitedStates() const noexcept { return tail_; }
+
+    /**
+     * @brief Build the piece locked at a placement
+     * @param placement One of the last search's placements
+     * @return Piece of the searched type at that position and rotation
+     */
+    [[nodiscard]] Tetromino piece(const Placement& placement) const {
+        return Tetromino(type_, placement.position).withRotation(placement.rotation);
+    }
+
+    /**
+     * @brief Look up the placement covering the same cells as a lock position
+     * @param position Frame position of the lock position
+     * @param rotation Its rotation (any rotation with the same cells matches)
+     * @return Index into the last search's placements, or -1 if it was not reached
+     */
+    [[nodiscard]] int find(const Position& position, Rotation rotation) const noexcept;
+
+    /**
+     * @brief Rebuild the shortest input sequence to a placement
+     *
+     * Shifts and rotations come before the drops they share a length with,
+     * and the final run of soft drops is replaced by one hard drop.
+     *
+     * @param placement One of the last search's placements
+     * @param path Receives the actions, ending with HARD_DROP
+     */
+    void path(const Placement& placement, Path& path) const noexcept;
+
+private:
+    static constexpr uint16_t NO_PARENT = 0xFFFF;
+
+    struct Node {
+        int8_t x;
+        int8_t y;
+        uint8_t rotation;
+    };
+
+    // Rotation whose cells match, and the frame shift that lines them up
+    struct CanonicalRotation {
+        uint8_t rotation;
+        int8_t dx;
+        int8_t dy;
+    };
+
+    static constexpr std::array<std::array<CanonicalRotation, ROTATION_COUNT>, PIECE_TYPE_COUNT> CANONICAL = [] {
+        std::array<std::array<CanonicalRotation, ROTATION_COUNT>, PIECE_TYPE_COUNT> table{};
+        for (int type = 0; type < PIECE_TYPE_COUNT; ++type) {
+            for (int rot = 0; rot < ROTATION_COUNT; ++rot) {
+                const PieceGeometry& g = PIECE_GEOMETRY[type][rot];
+                for (int other = 0; other <= rot; ++other) {
+                    const PieceGeometry& o = PIECE_GEOMETRY[type][other];
+                    bool same = g.max_y - g.min_y == o.max_y - o.min_y;
+                    for (int y = 0; same && y <= g.max_y - g.min_y; ++y) {
+                        same = g.row_masks[g.min_y + y] == o.row_masks[o.min_y + y];
+                    }
+                    if (same) {
+                        table[type][rot] = {static_cast<uint8_t>(other), static_cast<int8_t>(g.min_x - o.min_x),
+                                            static_cast<int8_t>(g.min_y - o.min_y)};
+                        break;
+                    }
+                }
+            }
+        }
+        return table;
+    }();
+
+    using StateBits = std::array<uint64_t, (STATE_COUNT + 63) / 64>;
+
+    // Bit FRAME_MARGIN + x of blocked_[rotation][FRAME_MARGIN + y] is set if the piece collides at (x, y);
+    // one extra row lets the search test a drop from the lowest frame row
+    std::array<std::array<uint64_t, SPAN_Y + 1>, ROTATION_COUNT> blocked_{};
+    TetrominoType type_{TetrominoType::NONE};
+    StateBits visited_{};
+    StateBits locked_{};
+    std::array<Node, STATE_COUNT> queue_{};
+    std::array<uint16_t, STATE_COUNT> parent_{};
+    std::array<InputAction, STATE_COUNT> action_{};
+    std::array<Placement, STATE_COUNT> placements_{};
+    int tail_{0};
+    int count_{0};
+
+    [[nodiscard]] static constexpr int stateIndex(int x, int y, int rotation) noexcept {
+        return (rotation * SPAN_Y + y + FRAME_MARGIN) * SPAN_X + x + FRAME_MARGIN;
+    }
+
+    [[nodiscard]] static bool testAndSet(StateBits& bits, int index) noexcept {
+        uint64_t& word = bits[static_cast<size_t>(index) >> 6];
+        const uint64_t bit = uint64_t{1} << (index & 63);
+        const bool was_set = word & bit;
+        word |= bit;
+        return was_set;
+    }
+
+    /**
+     * @brief Check a frame position against the collision masks
+     */
+    [[nodiscard]] bool fits(int rotation, int x, int y) const noexcept {
+        return !((blocked_[rotation][y + FRAME_MARGIN] >> (x + FRAME_MARGIN)) & 1);
+    }
+
+    /**
+     * @brief Build the collision masks of the current piece type on a board
+     */
+    void buildCollisionMasks(const BoardType& board) noexcept;
+
+    /**
+     * @brief Queue a state if it has not been reached yet
+     */
+    void visit(int x, int y, int rotation, uint16_t parent, InputAction action) noexcept;
+
+    /**
+     * @brief Queue the state a rotation leads to, trying kicks like the game does
+     */
+    void rotate(const Node& node, int rotation, uint16_t parent, InputAction action) noexcept;
+};
+
+template <int Width, int Height>
+void BasicMoveGenerator<Width, Height>::buildCollisionMasks(const BoardType& board) noexcept {
+    // Board rows with FRAME_MARGIN wall bits on the left and wall bits past the right edge
+    constexpr uint64_t WALLS = ((uint64_t{1} << FRAME_MARGIN) - 1) | (~uint64_t{0} << (Width + FRAME_MARGIN));
+    std::array<uint64_t, Height> padded{};
+    for (int y = 0; y < Height; ++y) {
+        padded[y] = (static_cast<uint64_t>(board.getRowMasks()[y]) << FRAME_MARGIN) | WALLS;
+    }
+
+    for (int rotation = 0; rotation < ROTATION_COUNT; ++rotation) {
+        const PieceGeometry& geometry = Tetromino::geometry(type_, static_cast<Rotation>(rotation));
+        for (int frame_y = 0; frame_y <= SPAN_Y; ++frame_y) {
+            uint64_t blocked = 0;
+            for (int row = geometry.min_y; row <= geometry.max_y; ++row) {
+                // Rows above the top or below the floor block every column
+                const int y = frame_y - FRAME_MARGIN + row;
+                const uint64_t board_row = y >= 0 && y < Height ? padded[y] : ~uint64_t{0};
+                for (uint64_t cells = geometry.row_masks[row]; cells; cells &= cells - 1) {
+                    blocked |= board_row >> (geometry.min_x + countTrailingZeros(cells));
+                }
+            }
+            blocked_[rotation][frame_y] = blocked;
+        }
+    }
+}
+
+template <int Width, int Height>
+void BasicMoveGenerator<Width, Height>::visit(int x, int y, int rotation, uint16_t parent, InputAction action) noexcept {
+    const int index = stateIndex(x, y, rotation);
+    if (testAndSet(visited_, index)) return;
+    parent_[index] = parent;
+    action_[index] = action;
+    queue_[tail_++] = {static_cast<int8_t>(x), static_cast<int8_t>(y), static_cast<uint8_t>(rotation)};
+}
+
+template <int Width, int Height>
+void BasicMoveGenerator<Width, Height>::rotate(const Node& node, int rotation, uint16_t parent, InputAction action) noexcept {
+    if (fits(rotation, node.x, node.y)) {
+        visit(node.x, node.y, rotation, parent, action);
+        return;
+    }
+    for (const auto& kick : BoardType::KICK_OFFSETS) {
+        if (fits(rotation, node.x + kick.x, node.y + kick.y)) {
+            visit(node.x + kick.x, node.y + kick.y, rotation, parent, action);
+            return;
+        }
+    }
+}
+
+template <int Width, int Height>
+int BasicMoveGenerator<Width, Height>::generate(const BoardType& board, const Tetromino& piece) noexcept {
+    tail_ = 0;
+    count_ = 0;
+    if (!board.canPlacePiece(piece)) {
+        return 0;
+    }
+    type_ = piece.getType();
+    visited_.fill(0);
+    locked_.fill(0);
+    buildCollisionMasks(board);
+
+    const Position& start = piece.getPosition();
+    const int start_rotation = static_cast<int>(piece.getRotation());
+    visit(start.x, start.y, start_rotation, NO_PARENT, InputAction::NONE);
+
+    const auto& canonical = CANONICAL[static_cast<size_t>(type_)];
+    for (int head = 0; head < tail_; ++head) {
+        const Node node = queue_[head];
+        const auto from = static_cast<uint16_t>(stateIndex(node.x, node.y, node.rotation));
+
+        // Shifts and rotations are queued before the drop so paths prefer them first
+        if (fits(node.rotation, node.x - 1, node.y)) visit(node.x - 1, node.y, node.rotation, from, InputAction::MOVE_LEFT);
+        if (fits(node.rotation, node.x + 1, node.y)) visit(node.x + 1, node.y, node.rotation, from, InputAction::MOVE_RIGHT);
+        rotate(node, (node.rotation + 1) % ROTATION_COUNT, from, InputAction::ROTATE_CW);
+        rotate(node, (node.rotation + 3) % ROTATION_COUNT, from, InputAction::ROTATE_CCW);
+        if (fits(node.rotation, node.x, node.y + 1)) {
+            visit(node.x, node.y + 1, node.rotation, from, InputAction::SOFT_DROP);
+            continue;
+        }
+
+        // Resting on the stack or the floor: a lock position, unless its cells were already reported
+        const CanonicalRotation& same = canonical[node.rotation];
+        if (!testAndSet(locked_, stateIndex(node.x + same.dx, node.y + same.dy, same.rotation))) {
+            placements_[count_++] = {{node.x, node.y}, static_cast<Rotation>(node.rotation), from};
+        }
+    }
+    return count_;
+}
+
+template <int Width, int Height>
+int BasicMoveGenerator<Width, Height>::find(const Position& position, Rotation rotation) const noexcept {
+    const auto& canonical = CANONICAL[static_cast<size_t>(type_)];
+    const CanonicalRotation& target = canonical[static_cast<size_t>(rotation)];
+    const Position target_pos{position.x + target.dx, position.y + target.dy};
+    for (int i = 0; i < count_; ++i) {
+        const CanonicalRotation& same = canonical[static_cast<size_t>(placements_[i].rotation)];
+        if (same.rotation == target.rotation && placements_[i].position + Position{same.dx, same.dy} == target_pos) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+template <int Width, int Height>
+void BasicMoveGenerator<Width, Height>::path(const Placement& placement, Path& path) const noexcept {
+    path.length = 0;
+    for (uint16_t state = placement.state; parent_[state] != NO_PARENT; state = parent_[state]) {
+        path.actions[path.length++] = action_[state];
+    }
+    std::reverse(path.actions.begin(), path.actions.begin() + path.length);
+    while (path.length > 0 && path.actions[path.length - 1] == InputAction::SOFT_DROP) {
+        path.length--;
+    }
+    path.actions[path.length++] = InputAction::HARD_DROP;
+}
+
+/**
+ * @brief Move generator for the standard 10x20 board
+ */
+using MoveGenerator = BasicMoveGenerator<Board::WIDTH, Board::HEIGHT>;
+
+} // namespace Tetris
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Tetromino.h"
+#include <array>
+
+namespace Tetris {
+
+/**
+ * @brief The pieces a lookahead search knows are coming: the falling one and the next one
+ */
+struct PieceQueue {
+    std::array<TetrominoType, 2> pieces{};
+    int length{0};
+};
+
+/**
+ * @brief One way to take the next piece in a search: which piece goes down and what is left
+ */
+struct PieceChoice {
+    TetrominoType piece{TetrominoType::NONE};      // Piece placed
+    TetrominoType hold{TetrominoType::NONE};       // Held piece afterwards
+    int next{0};                                   // Queue index of the first unplaced piece afterwards
+    bool held{false};                              // Went through hold
+};
+
+/**
+ * @brief List the pieces a search node may place
+ *
+ * Either the first unplaced queue piece goes down, or (if holding is
+ * allowed) it is swapped into hold and the piece that comes out goes down
+ * instead: the held piece, or with an empty hold the queue piece after it.
+ * A hold that would place the same type as not holding is left out. Every
+ * choice uses up one known piece, so all paths through the known pieces
+ * are equally long.
+ *
+ * @param queue Known pieces
+ * @param hold Held piece at this node (NONE if empty)
+ * @param next Queue index of the first unplaced piece
+ * @param hold_allowed Whether this node may hold
+ * @param choices Filled with the choices
+ * @return Number of choices (0 once every known piece is placed)
+ */
+[[nodiscard]] inline int pieceChoices(const PieceQueue& queue, TetrominoType hold, int next, bool hold_allowed,
+                                      std::array<PieceChoice, 2>& choices) noexcept {
+    int count = 0;
+    const bool queued = next < queue.length;
+    if (queued) {
+        choices[count++] = {queue.pieces[next], hold, next + 1, false};
+    }
+    if (!hold_allowed) return count;
+
+    if (hold != TetrominoType::NONE) {
+        const TetrominoType incoming = queued ? queue.pieces[next] : TetrominoType::NONE;
+        if (hold != incoming) {
+            choices[count++] = {hold, incoming, queued ? next + 1 : next, true};
+        }
+    } else if (next + 1 < queue.length && queue.pieces[next + 1] != queue.pieces[next]) {
+        choices[count++] = {queue.pieces[next + 1], queue.pieces[next], next + 2, true};
+    }
+    return count;
+}
+
+} // namespace Tetris
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace Tetris {
+
+/**
+ * @brief Number of distinct piece types and rotation states
+ */
+constexpr int PIECE_TYPE_COUNT = 7;
+constexpr int ROTATION_COUNT = 4;
+
+/**
+ * @brief Offset of a filled cell inside a piece's 4x4 frame
+ */
+struct CellOffset {
+    int8_t x{0};
+    int8_t y{0};
+};
+
+/**
+ * @brief Precomputed geometry of one piece type in one rotation
+ *
+ * All values are relative to the piece's 4x4 frame, whose top-left corner
+ * is the Tetromino position. Row masks are shifted so that bit 0 is column
+ * min_x; a piece at frame x covers board columns starting at x + min_x.
+ */
+struct PieceGeometry {
+    std::array<uint8_t, 4> row_masks{};        // Filled cells per frame row, bit 0 = column min_x
+    std::array<CellOffset, 4> cells{};         // The four filled cells in row-major order
+    int8_t min_x{0};                           // Bounding box inside the frame (inclusive)
+    int8_t max_x{0};
+    int8_t min_y{0};
+    int8_t max_y{0};
+    std::array<int8_t, 4> column_bottom{};     // Lowest filled row per frame column, -1 if empty
+};
+
+using PieceBlockGrid = std::array<std::array<bool, 4>, 4>;
+
+/**
+ * @brief Shape of every piece type and rotation as a 16-bit 4x4 bitmap
+ *
+ * Frame row r occupies bits 4r..4r+3 and bit 4r+x is frame column x.
+ * Order follows TetrominoType (I, O, T, S, Z, J, L) and Rotation
+ * (NORTH, EAST, SOUTH, WEST).
+ */
+inline constexpr std::array<std::array<uint16_t, ROTATION_COUNT>, PIECE_TYPE_COUNT> PIECE_SHAPE_BITS = {{
+    {{0x00F0, 0x4444, 0x0F00, 0x2222}},   // I
+    {{0x0066, 0x0066, 0x0066, 0x0066}},   // O
+    {{0x0072, 0x0262, 0x0270, 0x0232}},   // T
+    {{0x0036, 0x0462, 0x0360, 0x0231}},   // S
+    {{0x0063, 0x0264, 0x0630, 0x0132}},   // Z
+    {{0x0071, 0x0226, 0x0470, 0x0322}},   // J
+    {{0x0074, 0x0622, 0x0170, 0x0223}},   // L
+}};
+
+/**
+ * @brief Derive the full geometry of a shape bitmap at compile time
+ * @param bits 4x4 shape bitmap (see PIECE_SHAPE_BITS)
+ * @return Masks, cell list, bounding box and column-bottom profile
+ */
+constexpr PieceGeometry makePieceGeometry(uint16_t bits) {
+    PieceGeometry geometry{};
+    geometry.min_x = 4;
+    geometry.min_y = 4;
+    geometry.max_x = -1;
+    geometry.max_y = -1;
+    for (int x = 0; x < 4; ++x) {
+        geometry.column_bottom[x] = -1;
+    }
+
+    int count = 0;
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            if (!(bits & (1u << (y * 4 + x)))) continue;
+            if (count < 4) {
+                geometry.cells[count] = CellOffset{static_cast<int8_t>(x), static_cast<int8_t>(y)};
+            }
+            ++count;
+            if (x < geometry.min_x) geometry.min_x = static_cast<int8_t>(x);
+            if (x > geometry.max_x) geometry.max_x = static_cast<int8_t>(x);
+            if (y < geometry.min_y) geometry.min_y = static_cast<int8_t>(y);
+            if (y > geometry.max_y) geometry.max_y = static_cast<int8_t>(y);
+            geometry.column_bottom[x] = static_cast<int8_t>(y);
+        }
+    }
+    for (int y = 0; y < 4; ++y) {
+        geometry.row_masks[y] = static_cast<uint8_t>(((bits >> (y * 4)) & 0xF) >> geometry.min_x);
+    }
+    return geometry;
+}
+
+/**
+ * @brief Expand a shape bitmap into a 4x4 bool grid at compile time
+ * @param bits 4x4 shape bitmap (see PIECE_SHAPE_BITS)
+ * @return Grid indexed [row][column]
+ */
+constexpr PieceBlockGrid makePieceBlockGrid(uint16_t bits) {
+    PieceBlockGrid grid{};
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            grid[y][x] = (bits & (1u << (y * 4 + x))) != 0;
+        }
+    }
+    return grid;
+}
+
+/**
+ * @brief Build a per-(type, rotation) table by applying a generator to every shape
+ */
+template <typename T, typename Generator>
+constexpr std::array<std::array<T, ROTATION_COUNT>, PIECE_TYPE_COUNT> makePieceTable(Generator generate) {
+    std::array<std::array<T, ROTATION_COUNT>, PIECE_TYPE_COUNT> table{};
+    for (int type = 0; type < PIECE_TYPE_COUNT; ++type) {
+        for (int rot = 0; rot < ROTATION_COUNT; ++rot) {
+            table[type][rot] = generate(PIECE_SHAPE_BITS[type][rot]);
+        }
+    }
+    return table;
+}
+
+/**
+ * @brief Geometry of every piece type and rotation, indexed [type][rotation]
+ */
+inline constexpr auto PIECE_GEOMETRY = makePieceTable<PieceGeometry>(makePieceGeometry);
+
+/**
+ * @brief 4x4 bool grid of every piece type and rotation, indexed [type][rotation]
+ */
+inline constexpr auto PIECE_BLOCK_GRIDS = makePieceTable<PieceBlockGrid>(makePieceBlockGrid);
+
+/**
+ * @brief Compile-time check that every shape has exactly four cells
+ */
+constexpr bool allShapesHaveFourCells() {
+    for (const auto& rotations : PIECE_SHAPE_BITS) {
+        for (const uint16_t bits : rotations) {
+            int count = 0;
+            for (int i = 0; i < 16; ++i) {
+                count += (bits >> i) & 1;
+            }
+            if (count != 4) return false;
+        }
+    }
+    return true;
+}
+
+static_assert(allShapesHaveFourCells(), "every tetromino shape must have four cells");
+
+/**
+ * @brief Console color index of every piece type (I=cyan, O=yellow, T=purple, S=green, Z=red, J=blue, L=orange)
+ */
+inline constexpr std::array<uint8_t, PIECE_TYPE_COUNT> PIECE_COLORS = {6, 3, 5, 2, 1, 4, 11};
+
+/**
+ * @brief 3-bit code of every console color: piece type index + 1 for piece colors, 0 otherwise
+ */
+inline constexpr std::array<uint8_t, 16> COLOR_CODES = [] {
+    std::array<uint8_t, 16> codes{};
+    for (int type = 0; type < PIECE_TYPE_COUNT; ++type) {
+        codes[PIECE_COLORS[type]] = static_cast<uint8_t>(type + 1);
+    }
+    return codes;
+}();
+
+/**
+ * @brief Pack a cell color into 3 bits
+ * @param color Cell color (0 = empty or a piece color)
+ * @return Code 0-7 (0 = empty)
+ */
+[[nodiscard]] constexpr uint8_t colorCode(uint8_t color) noexcept {
+    return color < COLOR_CODES.size() ? COLOR_CODES[color] : 0;
+}
+
+/**
+ * @brief Unpack a 3-bit code into a cell color
+ * @param code Code from colorCode()
+ * @return Cell color (0 = empty)
+ */
+[[nodiscard]] constexpr uint8_t codeColor(uint8_t code) noexcept {
+    return code == 0 ? 0 : PIECE_COLORS[code - 1];
+}
+
+/**
+ * @brief Compile-time check that piece colors survive the 3-bit round trip
+ */
+constexpr bool colorCodesRoundTrip() {
+    for (const uint8_t color : PIECE_COLORS) {
+        if (color == 0 || codeColor(colorCode(color)) != color) return false;
+    }
+    return true;
+}
+
+static_assert(colorCodesRoundTrip(), "piece colors must be distinct, non-zero and below 16");
+
+} // namespace Tetris
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "BoardHash.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+namespace Tetris {
+
+/**
+ * @brief PCG32 (PCG-XSH-RR, 64-bit state, 32-bit output) random generator
+ *
+ * 16 bytes of state, a multiply-add per draw, and output fully specified by
+ * the algorithm itself: seeding, bounded draws and shuffles are written out
+ * here rather than left to std::uniform_int_distribution or std::shuffle,
+ * whose results differ between standard libraries. The same seed therefore
+ * deals the same pieces with every compiler. Also usable anywhere a
+ * standard UniformRandomBitGenerator is expected.
+ */
+class Pcg32 {
+public:
+    using result_type = uint32_t;
+
+    /**
+     * @brief Seed from a single 64-bit value (state and stream derived with splitmix64)
+     * @param seed Any value; distinct seeds give unrelated sequences
+     */
+    explicit Pcg32(uint64_t seed = 0) noexcept { this->seed(seed); }
+
+    /**
+     * @brief Seed exactly like the reference pcg32_srandom_r(initstate, initseq)
+     * @param initstate Starting state
+     * @param initseq Stream selector (only the low 63 bits matter)
+     */
+    Pcg32(uint64_t initstate, uint64_t initseq) noexcept { seed(initstate, initseq); }
+
+    /**
+     * @brief Reseed from a single 64-bit value
+     * @param seed Any value
+     */
+    void seed(uint64_t seed) noexcept {
+        const uint64_t initstate = mix64(seed + 0x9e3779b97f4a7c15ULL);
+        const uint64_t initseq = mix64(seed + 2 * 0x9e3779b97f4a7c15ULL);
+        this->seed(initstate, initseq);
+    }
+
+    /**
+     * @brief Reseed like the reference pcg32_srandom_r
+     * @param initstate Starting state
+     * @param initseq Stream selector
+     */
+    void seed(uint64_t initstate, uint64_t initseq) noexcept {
+        state_ = 0;
+        increment_ = (initseq << 1) | 1;
+        next();
+        state_ += initstate;
+        next();
+    }
+
+    /**
+     * @brief Draw 32 random bits
+     * @return Next output
+     */
+    uint32_t next() noexcept {
+        const uint64_t old = state_;
+        state_ = old * 6364136223846793005ULL + increment_;
+        const auto xorshifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+        const auto rot = static_cast<uint32_t>(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31));
+    }
+
+    /**
+     * @brief Draw a uniform value in [0, bound) without modulo bias
+     *
+     * Lemire's multiply-and-reject method: the high half of a 32x32-bit
+     * product, redrawing in the rare case that would be biased.
+     *
+     * @param bound Exclusive upper bound (must be non-zero)
+     * @return Value in [0, bound)
+     */
+    uint32_t bounded(uint32_t bound) noexcept {
+        uint64_t product = static_cast<uint64_t>(next()) * bound;
+        auto low = static_cast<uint32_t>(product);
+        if (low < bound) {
+            const uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                product = static_cast<uint64_t>(next()) * bound;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+    /**
+     * @brief Fisher-Yates shuffle (last slot first) using bounded()
+     * @param items Array to shuffle in place
+     */
+    template <typename T, size_t N>
+    void shuffle(std::array<T, N>& items) noexcept {
+        for (size_t i = N; i > 1; --i) {
+            const size_t j = bounded(static_cast<uint32_t>(i));
+            std::swap(items[i - 1], items[j]);
+        }
+    }
+
+    uint32_t operator()() noexcept { return next(); }
+    static constexpr uint32_t min() noexcept { return 0; }
+    static constexpr uint32_t max() noexcept { return std::numeric_limits<uint32_t>::max(); }
+
+private:
+    uint64_t state_{0};
+    uint64_t increment_{1}; // Stream, always odd
+};
+
+} // namespace Tetris
@@ -10,6 +10,9 @@
 
 namespace Tetris {
 
+class BoardOverlayView;
+struct ViewCell;
+
 /**
  * @brief Color enumeration for console rendering
  */
@@ -121,6 +124,10 @@ public:
     
     /**
      * @brief Render only the game board (optimized update)
+     * 
+     * The active piece and, if enabled, its ghost are overlaid through a
+     * BoardOverlayView instead of copying the board.
+     * 
      * @param board Game board to render
      * @param current_piece Current falling piece
      */
@@ -290,13 +297,13 @@ private:
     void platformSetCursorVisible(bool visible);
     
     /**
-     * @brief Render a single board cell
+     * @brief Render a single overlaid board cell
+     * @param view Overlay view the cell came from
      * @param cell Cell to render
      * @param x X position
      * @param y Y position
-     * @param show_ghost Whether this is a ghost piece cell
      */
-    void renderCell(const Cell& cell, int x, int y, bool show_ghost = false);
+    void renderCell(const BoardOverlayView& view, const ViewCell& cell, int x, int y);
     
     /**
      * @brief Render board borders and frame
@@ -0,0 +1,196 @@
+#pragma once
+
+#include "GameSimulation.h"
+#include "Input.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Tetris {
+
+/**
+ * @brief One recorded input: the action applied before the given tick
+ */
+struct ReplayEvent {
+    uint64_t tick{0};                          // Simulation ticks completed when the action was applied
+    InputAction action{InputAction::NONE};
+
+    bool operator==(const ReplayEvent& other) const noexcept { return tick == other.tick && action == other.action; }
+    bool operator!=(const ReplayEvent& other) const noexcept { return !(*this == other); }
+};
+
+/**
+ * @brief Final state of a recorded game, used to verify a replay
+ */
+struct ReplayResult {
+    int score{0};
+    int lines_cleared{0};
+    int total_pieces{0};
+    uint64_t ticks{0};
+
+    bool operator==(const ReplayResult& other) const noexcept {
+        return score == other.score && lines_cleared == other.lines_cleared &&
+               total_pieces == other.total_pieces && ticks == other.ticks;
+    }
+    bool operator!=(const ReplayResult& other) const noexcept { return !(*this == other); }
+
+    /**
+     * @brief Read the final state of a simulation
+     * @param sim Simulation to read
+     * @return Its score, lines, pieces and ticks
+     */
+    [[nodiscard]] static ReplayResult of(const GameSimulation& sim) noexcept {
+        return {sim.getScore(), sim.getLinesCleared(), sim.getCounters().total_pieces, sim.getCounters().ticks};
+    }
+};
+
+/**
+ * @brief A game recorded as its seed plus the input stream
+ *
+ * GameSimulation is deterministic, so the seed, the rule flags and every
+ * effective action with the tick it was applied on are enough to replay a
+ * game exactly. Difficulty and score tables are not stored; a replay is
+ * played back under the same ones it was recorded with.
+ *
+ * Binary format (little-endian, varint = LEB128):
+ *   "TRPL", version byte, flags byte (bit 0 = 7-bag, bit 1 = hold), seed (8 bytes),
+ *   event count (varint), per event varint((tick delta << 4) | action),
+ *   end tick delta (varint), final score, lines and pieces (varints).
+ * A typical event costs one or two bytes.
+ */
+class Replay {
+public:
+    static constexpr std::array<char, 4> MAGIC = {'T', 'R', 'P', 'L'};
+    static constexpr uint8_t VERSION = 1;
+
+    Replay() = default;
+
+    /**
+     * @brief Start a recording
+     * @param seed Seed the game was started with
+     * @param config Rules the game runs under (the hold and 7-bag flags are stored)
+     */
+    Replay(uint64_t seed, const GameSimulation::Config& config);
+
+    /**
+     * @brief Append an action
+     * @param tick Ticks completed when the action was applied (not before the previous event's)
+     * @param action Gameplay action that changed the game
+     * @throws std::invalid_argument If the tick goes backwards
+     */
+    void record(uint64_t tick, InputAction action);
+
+    /**
+     * @brief Store the final state once the game has ended or been abandoned
+     * @param sim Simulation the recording was taken from
+     */
+    void finish(const GameSimulation& sim) noexcept { result_ = ReplayResult::of(sim); }
+
+    /**
+     * @brief Copy the recorded rule flags into a configuration
+     * @param config Base configuration (difficulty and scoring are kept)
+     * @return Configuration to replay under
+     */
+    [[nodiscard]] GameSimulation::Config configure(GameSimulation::Config config) const noexcept;
+
+    [[nodiscard]] uint64_t getSeed() const noexcept { return seed_; }
+    [[nodiscard]] const std::vector<ReplayEvent>& getEvents() const noexcept { return events_; }
+    [[nodiscard]] const ReplayResult& getResult() const noexcept { return result_; }
+
+    /**
+     * @brief Serialize to the binary format
+     * @return Encoded bytes
+     */
+    [[nodiscard]] std::vector<uint8_t> encode() const;
+
+    /**
+     * @brief Parse the binary format
+     * @param data Encoded bytes
+     * @return Decoded replay
+     * @throws std::runtime_error If the data is truncated, malformed or of another version
+     */
+    [[nodiscard]] static Replay decode(const std::vector<uint8_t>& data);
+
+    /**
+     * @brief Write the encoded replay to a file
+     * @param path File to create or overwrite
+     * @throws std::runtime_error If the file cannot be written
+     */
+    void save(const std::string& path) const;
+
+    /**
+     * @brief Read a replay file
+     * @param path File to read
+     * @return Decoded replay
+     * @throws std::runtime_error If the file cannot be read or decoded
+     */
+    [[nodiscard]] static Replay load(const std::string& path);
+
+    bool operator==(const Replay& other) const noexcept {
+        return seed_ == other.seed_ && enable_7_bag_ == other.enable_7_bag_ && enable_hold_ == other.enable_hold_ &&
+               events_ == other.events_ && result_ == other.result_;
+    }
+    bool operator!=(const Replay& other) const noexcept { return !(*this == other); }
+
+private:
+    uint64_t seed_{0};
+    bool enable_7_bag_{true};
+    bool enable_hold_{true};
+    std::vector<ReplayEvent> events_;
+    ReplayResult result_;
+};
+
+/**
+ * @brief Re-runs a Replay on a GameSimulation, one tick at a time or all at once
+ *
+ * The player has no clock of its own: runToEnd() replays at full speed,
+ * and a front end that calls step() once per TICK_DURATION shows the game
+ * in real time.
+ */
+class ReplayPlayer {
+public:
+    /**
+     * @brief Configure the simulation from the replay and start its game
+     * @param replay Recording to play (must outlive the player)
+     * @param sim Simulation to drive (its difficulty and scoring are kept)
+     */
+    ReplayPlayer(const Replay& replay, GameSimulation& sim);
+
+    /**
+     * @brief Apply the actions recorded for the current tick, then advance one tick
+     * @return False once the recording has ended (nothing more to play)
+     */
+    bool step();
+
+    /**
+     * @brief Play the remaining recording at full speed
+     */
+    void runToEnd();
+
+    /**
+     * @brief Check if the whole recording has been played
+     * @return True when finished
+     */
+    [[nodiscard]] bool isFinished() const noexcept { return finished_; }
+
+    /**
+     * @brief Check the replayed game against the recorded final state
+     * @return True if score, lines, pieces and ticks all match
+     */
+    [[nodiscard]] bool matchesRecording() const noexcept { return ReplayResult::of(sim_) == replay_.getResult(); }
+
+private:
+    const Replay& replay_;
+    GameSimulation& sim_;
+    size_t next_event_{0};
+    bool finished_{false};
+
+    /**
+     * @brief Apply every event recorded for the simulation's current tick
+     */
+    void applyDueEvents();
+};
+
+} // namespace Tetris
@@ -1,7 +1,10 @@
 #pragma once
 
+#include "PieceTable.h"
+#include "Random.h"
 #include <array>
 #include <vector>
+#include <cstddef>
 #include <cstdint>
 
 namespace Tetris {
@@ -65,8 +68,7 @@ enum class Rotation : uint8_t {
 class Tetromino {
 public:
     // Each piece is defined as a 4x4 grid of blocks
-    using BlockGrid = std::array<std::array<bool, 4>, 4>;
-    using ShapeArray = std::array<BlockGrid, 4>; // 4 rotation states
+    using BlockGrid = PieceBlockGrid;
     
     /**
      * @brief Construct a Tetromino with specified type and position
@@ -132,6 +134,40 @@ public:
      */
     [[nodiscard]] const BlockGrid& getCurrentShape() const noexcept;
     
+    /**
+     * @brief Get the shape grid for a specific rotation
+     * @param rot The rotation to look up
+     * @return 4x4 grid representing the piece shape at that rotation
+     */
+    [[nodiscard]] const BlockGrid& getShape(Rotation rot) const noexcept;
+    
+    /**
+     * @brief Get the precomputed geometry for the current rotation
+     * @return Row masks, cells, bounding box and column-bottom profile
+     */
+    [[nodiscard]] const PieceGeometry& getGeometry() const noexcept { return getGeometry(rotation_); }
+    
+    /**
+     * @brief Get the precomputed geometry for a specific rotation
+     * @param rot The rotation to look up
+     * @return Geometry for this piece type at that rotation (empty for NONE)
+     */
+    [[nodiscard]] const PieceGeometry& getGeometry(Rotation rot) const noexcept {
+        return geometry(type_, rot);
+    }
+    
+    /**
+     * @brief Look up the precomputed geometry of any piece type and rotation
+     * @param type The piece type (NONE yields an empty geometry)
+     * @param rot The rotation
+     * @return Reference into the compile-time geometry table
+     */
+    [[nodiscard]] static const PieceGeometry& geometry(TetrominoType type, Rotation rot) noexcept {
+        static constexpr PieceGeometry empty_geometry{};
+        if (type >= TetrominoType::NONE) return empty_geometry;
+        return PIECE_GEOMETRY[static_cast<std::size_t>(type)][static_cast<std::size_t>(rot)];
+    }
+    
     /**
      * @brief Get occupied positions relative to piece position
      * @return Vector of positions occupied by this piece
@@ -186,31 +222,27 @@ private:
     TetrominoType type_{TetrominoType::NONE};
     Position position_{0, 0};
     Rotation rotation_{Rotation::NORTH};
-    
-    // Static shape definitions for all piece types and rotations
-    static const std::array<ShapeArray, 7> PIECE_SHAPES;
-    
-    /**
-     * @brief Initialize shape data for all piece types
-     * @return Array of shape definitions
-     */
-    static std::array<ShapeArray, 7> initializePieceShapes();
-    
-    /**
-     * @brief Get shape array for a specific piece type
-     * @param type The piece type
-     * @return Reference to the shape array for that type
-     */
-    [[nodiscard]] static const ShapeArray& getShapeArray(TetrominoType type) noexcept;
 };
 
 /**
  * @brief Factory function to create a random Tetromino
+ * 
+ * Draws from a per-thread generator seeded from std::random_device, so the
+ * result is not reproducible; pass a Pcg32 for a seeded sequence.
+ * 
  * @param pos Starting position for the piece
  * @return Randomly generated Tetromino
  */
 [[nodiscard]] Tetromino createRandomTetromino(const Position& pos = {0, 0});
 
+/**
+ * @brief Factory function to create a random Tetromino from a given generator
+ * @param rng Generator to draw the piece type from (one bounded draw)
+ * @param pos Starting position for the piece
+ * @return Uniformly chosen Tetromino
+ */
+[[nodiscard]] Tetromino createRandomTetromino(Pcg32& rng, const Position& pos = {0, 0});
+
 /**
  * @brief Factory function to create a specific Tetromino type
  * @param type The type of piece to create
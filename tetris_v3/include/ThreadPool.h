@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Tetris {
+
+/**
+ * @brief Fixed set of worker threads for data-parallel loops
+ *
+ * parallelFor() hands out loop indices from a shared atomic counter to the
+ * workers and to the calling thread, and returns once every index has run.
+ * Each call passes the worker number (0 = calling thread) so bodies can
+ * use per-worker scratch space without locking. Bodies must not throw.
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Start the workers
+     * @param threads Total threads including the caller (0 = one per hardware thread)
+     */
+    explicit ThreadPool(int threads = 0);
+
+    /**
+     * @brief Stop and join the workers
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Number of threads that run loop bodies, the caller included
+     * @return Thread count (at least 1)
+     */
+    [[nodiscard]] int size() const noexcept { return static_cast<int>(workers_.size()) + 1; }
+
+    /**
+     * @brief Run body(index, worker) for every index in [0, count) and wait for all of them
+     * @param count Number of indices
+     * @param body Loop body; worker is in [0, size())
+     */
+    void parallelFor(int count, const std::function<void(int index, int worker)>& body);
+
+private:
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+
+    // Current job, published under mutex_ by bumping generation_
+    const std::function<void(int, int)>* body_{nullptr};
+    int count_{0};
+    uint64_t generation_{0};
+    int busy_workers_{0};
+    bool stopping_{false};
+    std::atomic<int> next_index_{0};
+
+    /**
+     * @brief Worker loop: wait for a job, run indices, report completion
+     * @param worker Worker number (1-based; 0 is the calling thread)
+     */
+    void workerLoop(int worker);
+
+    /**
+     * @brief Take indices from the shared counter until none are left
+     */
+    void runIndices(const std::function<void(int, int)>& body, int count, int worker);
+};
+
+} // namespace Tetris
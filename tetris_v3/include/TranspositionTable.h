@@ -0,0 +1,205 @@
+#pragma once
+
+#include "Board.h"
+#include "BoardHash.h"
+#include "Tetromino.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace Tetris {
+
+/**
+ * @brief Fixed-size, lock-free cache of search results keyed by position
+ *
+ * A position is the board occupancy (Board::hash(), kept up to date by
+ * the board through placements and clears, so reading it is free and
+ * thread-safe) plus the piece about to be placed; key() combines them.
+ * Each entry stores the best score found below that position and the
+ * depth it was searched to.
+ *
+ * Slots are two 64-bit atomics written without locks: the score's bits,
+ * and the key with its low byte replaced by the depth, XORed with the
+ * score bits. A reader accepts a slot only if XORing the words back gives
+ * its key, so a slot torn by two threads writing at once reads as a miss
+ * rather than a wrong score. The bucket index supplies the key's low
+ * bits, which is why the table has at least 256 buckets.
+ *
+ * Slots come four to a 64-byte bucket. A store overwrites the same
+ * position if the new result is at least as deep, otherwise it takes an
+ * empty slot or evicts the shallowest one. Probe, hit, store and
+ * eviction counts go into a Stats the caller passes in, one per worker,
+ * as plain increments: a shared atomic counter costs about as much per
+ * probe as the evaluation the table saves.
+ */
+class TranspositionTable {
+public:
+    static constexpr int BUCKET_SLOTS = 4;
+    static constexpr int MAX_DEPTH = 254;
+
+    /**
+     * @brief Result read back from the table
+     */
+    struct Entry {
+        double score{0.0};
+        int depth{0};
+    };
+
+    /**
+     * @brief Usage counters kept by the caller (one per thread, summed with +=)
+     */
+    struct Stats {
+        uint64_t probes{0};
+        uint64_t hits{0};
+        uint64_t stores{0};
+        uint64_t evictions{0};                // Stores that replaced a different position
+
+        [[nodiscard]] double hitRate() const noexcept {
+            return probes ? static_cast<double>(hits) / static_cast<double>(probes) : 0.0;
+        }
+
+        Stats& operator+=(const Stats& other) noexcept {
+            probes += other.probes;
+            hits += other.hits;
+            stores += other.stores;
+            evictions += other.evictions;
+            return *this;
+        }
+    };
+
+    /**
+     * @brief Allocate an empty table
+     * @param megabytes Memory to use; rounded down to a power of two number of buckets
+     * @throws std::invalid_argument If megabytes is 0
+     */
+    explicit TranspositionTable(size_t megabytes);
+
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    /**
+     * @brief Key of a board with a piece to place
+     * @param board Board position
+     * @param piece Piece about to be placed
+     * @return 64-bit table key
+     */
+    template <int Width, int Height>
+    [[nodiscard]] static uint64_t key(const BasicBoard<Width, Height>& board, TetrominoType piece) noexcept {
+        return board.hash() ^ PIECE_KEYS[static_cast<size_t>(piece)];
+    }
+
+    /**
+     * @brief Look up a position
+     * @param key Position key
+     * @param entry Set to the stored result on a hit
+     * @param counters Caller's counters (probes, hits)
+     * @return True if the position was found
+     */
+    [[nodiscard]] bool probe(uint64_t key, Entry& entry, Stats& counters) const noexcept {
+        counters.probes++;
+        const Bucket& bucket = buckets_[key & bucket_mask_];
+        for (const Slot& slot : bucket.slots) {
+            const uint64_t data = slot.data.load(std::memory_order_relaxed);
+            const uint64_t tagged = slot.check.load(std::memory_order_relaxed) ^ data;
+            if ((tagged & ~DEPTH_MASK) == (key & ~DEPTH_MASK) && (tagged & DEPTH_MASK) != 0) {
+                entry.score = fromBits(data);
+                entry.depth = static_cast<int>(tagged & DEPTH_MASK) - 1;
+                counters.hits++;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Record a search result
+     * @param key Position key
+     * @param score Best score found
+     * @param depth Depth searched (clamped to 0..MAX_DEPTH)
+     * @param counters Caller's counters (stores, evictions)
+     */
+    void store(uint64_t key, double score, int depth, Stats& counters) noexcept {
+        counters.stores++;
+        depth = depth < 0 ? 0 : (depth > MAX_DEPTH ? MAX_DEPTH : depth);
+
+        Bucket& bucket = buckets_[key & bucket_mask_];
+        Slot* target = nullptr;
+        int target_depth = MAX_DEPTH + 2;
+        for (Slot& slot : bucket.slots) {
+            const uint64_t tagged = slot.check.load(std::memory_order_relaxed) ^ slot.data.load(std::memory_order_relaxed);
+            const int stored_depth = static_cast<int>(tagged & DEPTH_MASK) - 1;    // -1 = empty
+            if (stored_depth >= 0 && (tagged & ~DEPTH_MASK) == (key & ~DEPTH_MASK)) {
+                if (stored_depth > depth) return;      // Keep the deeper result
+                target = &slot;
+                target_depth = -2;
+                break;
+            }
+            if (stored_depth < target_depth) {
+                target = &slot;
+                target_depth = stored_depth;
+            }
+        }
+        if (target_depth >= 0) {
+            counters.evictions++;
+        }
+
+        const uint64_t data = toBits(score);
+        target->data.store(data, std::memory_order_relaxed);
+        target->check.store(((key & ~DEPTH_MASK) | static_cast<uint64_t>(depth + 1)) ^ data, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Empty every slot (not safe while other threads use the table)
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Fraction of slots in use, estimated from the first buckets
+     * @return Occupancy in [0, 1]
+     */
+    [[nodiscard]] double occupancy() const noexcept;
+
+    [[nodiscard]] size_t capacity() const noexcept { return (bucket_mask_ + 1) * BUCKET_SLOTS; }
+    [[nodiscard]] size_t sizeBytes() const noexcept { return (bucket_mask_ + 1) * sizeof(Bucket); }
+
+private:
+    static constexpr uint64_t DEPTH_MASK = 0xFF;
+
+    // Distinct per piece type (NONE included) so equal boards with different pieces key apart
+    static constexpr std::array<uint64_t, PIECE_TYPE_COUNT + 1> PIECE_KEYS = [] {
+        std::array<uint64_t, PIECE_TYPE_COUNT + 1> keys{};
+        for (size_t i = 0; i < keys.size(); ++i) {
+            keys[i] = mix64(0x51ece5ULL + i);
+        }
+        return keys;
+    }();
+
+    struct Slot {
+        std::atomic<uint64_t> check;
+        std::atomic<uint64_t> data;
+    };
+
+    struct alignas(64) Bucket {
+        std::array<Slot, BUCKET_SLOTS> slots;
+    };
+
+    std::unique_ptr<Bucket[]> buckets_;
+    size_t bucket_mask_{0};
+
+    [[nodiscard]] static uint64_t toBits(double value) noexcept {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    [[nodiscard]] static double fromBits(uint64_t bits) noexcept {
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+};
+
+} // namespace Tetris
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "Evaluator.h"
+#include "MoveGenerator.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Tetris {
+
+/**
+ * @brief Cross-entropy method search over evaluator weights
+ *
+ * The search keeps a Gaussian over weight vectors (a mean and a standard
+ * deviation per feature). Each generation samples a population from it,
+ * plays every candidate on the same seeded games, refits the Gaussian to
+ * the elite (the best fraction by mean lines cleared) and adds a little
+ * extra variance that fades over the first generations, so the search
+ * does not collapse early.
+ *
+ * Games are played straight on a Board with no ticks: pieces come from a
+ * 7-bag dealt by a Pcg32 seeded per game, and each piece goes where the
+ * candidate's Evaluator scores the MoveGenerator placements best, until
+ * the stack tops out or max_pieces is reached. Candidate/game pairs run
+ * in parallel on a ThreadPool; every game is a pure function of its
+ * weights and seed, and each generation's samples come from a Pcg32
+ * seeded by (seed, generation), so results do not depend on the thread
+ * count. A checkpoint records every setting but the thread count, and
+ * resume() refuses other settings, so a resumed run continues exactly.
+ */
+class WeightTuner {
+public:
+    /**
+     * @brief Search settings
+     */
+    struct Config {
+        int population{50};                      // Candidates per generation
+        int games{8};                            // Games per candidate
+        int max_pieces{500};                     // Game length cap
+        double elite_fraction{0.2};              // Share of candidates the Gaussian is refitted to
+        double initial_stddev{1.0};              // Starting standard deviation of every weight
+        double extra_noise{0.05};                // Variance added after refitting, at generation 0
+        int noise_generations{30};               // Generations over which the extra variance fades to 0
+        int threads{0};                          // Game threads (0 = one per hardware thread)
+
+        Config() = default;
+    };
+
+    /**
+     * @brief Everything needed to continue a search (what a checkpoint holds)
+     */
+    struct State {
+        uint64_t seed{1};                        // Seeds sampling and game pieces
+        int generation{0};                       // Generations completed
+        Evaluator::Weights mean{};
+        Evaluator::Weights stddev{};
+        Evaluator::Weights best{};               // Best candidate seen so far
+        double best_fitness{-1.0};               // Its mean lines cleared (-1 = none yet)
+        int population{0};                       // Config the search runs with; fitness is only
+        int games{0};                            // comparable across generations that share it,
+        int max_pieces{0};                       // and the rest also steer sampling and refitting
+        double elite_fraction{0.0};
+        double initial_stddev{0.0};
+        double extra_noise{0.0};
+        int noise_generations{0};
+    };
+
+    /**
+     * @brief What one generation did
+     */
+    struct Generation {
+        int generation{0};                       // Index of this generation (0-based)
+        std::vector<int> lines;                  // Lines cleared in every game, sorted
+        double mean_fitness{0.0};                // Mean over candidates of their mean lines
+        double elite_fitness{0.0};               // Mean over the elite
+        double best_fitness{0.0};                // Best candidate of the generation
+        Evaluator::Weights best_weights{};
+        double seconds{0.0};
+    };
+
+    /**
+     * @brief Construct a tuner
+     * @param config Search settings
+     * @throws std::invalid_argument If a setting is out of range
+     */
+    explicit WeightTuner(const Config& config);
+    ~WeightTuner();
+
+    WeightTuner(const WeightTuner&) = delete;
+    WeightTuner& operator=(const WeightTuner&) = delete;
+
+    /**
+     * @brief Start a new search around some weights
+     * @param initial Starting mean
+     * @param seed Seed for sampling and games
+     */
+    void start(const Evaluator::Weights& initial, uint64_t seed);
+
+    /**
+     * @brief Continue a search
+     * @param state State from a checkpoint
+     * @throws std::invalid_argument If the checkpoint was made with other settings (all but threads)
+     */
+    void resume(const State& state);
+
+    /**
+     * @brief Sample, play and refit one generation
+     * @return Its statistics
+     */
+    Generation runGeneration();
+
+    [[nodiscard]] const State& getState() const noexcept { return state_; }
+    [[nodiscard]] const Config& getConfig() const noexcept { return config_; }
+    [[nodiscard]] int threadCount() const noexcept { return pool_.size(); }
+
+    /**
+     * @brief Play one greedy game on a bare Board
+     * @param evaluator Scores placements
+     * @param seed Seeds the 7-bag piece sequence
+     * @param max_pieces Stop after this many pieces
+     * @param generator Move generator to use
+     * @return Lines cleared
+     */
+    static int playGame(const Evaluator& evaluator, uint64_t seed, int max_pieces, MoveGenerator& generator);
+
+    /**
+     * @brief Write a checkpoint
+     * @param out Stream to write
+     * @param state State to save
+     */
+    static void writeCheckpoint(std::ostream& out, const State& state);
+
+    /**
+     * @brief Read a checkpoint
+     * @param in Stream to read
+     * @param source Name used in error messages
+     * @return Saved state
+     * @throws std::runtime_error On a malformed or incomplete checkpoint
+     */
+    [[nodiscard]] static State parseCheckpoint(std::istream& in, const std::string& source = "checkpoint");
+
+    /**
+     * @brief Write a checkpoint file, replacing it only once the new one is complete
+     * @param path File to create or replace
+     * @param state State to save
+     * @throws std::runtime_error If the file cannot be written
+     */
+    static void saveCheckpoint(const std::string& path, const State& state);
+
+    /**
+     * @brief Read a checkpoint file
+     * @param path File to read
+     * @return Saved state
+     * @throws std::runtime_error If the file cannot be read or parsed
+     */
+    [[nodiscard]] static State loadCheckpoint(const std::string& path);
+
+private:
+    Config config_;
+    State state_;
+    ThreadPool pool_;
+    std::vector<std::unique_ptr<MoveGenerator>> generators_;  // One per worker
+    std::vector<Evaluator::Weights> candidates_;
+    std::vector<int> lines_;                                   // [candidate * games + game]
+};
+
+} // namespace Tetris
@@ -0,0 +1,248 @@
+#include "AutoPlayer.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace Tetris {
+
+namespace {
+
+// Scored below every board that is still in play
+constexpr double LOST_SCORE = -std::numeric_limits<double>::max();
+
+const AutoPlayer::Config& checkConfig(const AutoPlayer::Config& config) {
+    if (config.beam_width <= 0) {
+        throw std::invalid_argument("AutoPlayer beam width must be positive");
+    }
+    return config;
+}
+
+// Position after a placement: the board, what is left to place and the lines that feed into its score
+uint64_t positionKey(const Board& board, TetrominoType upcoming, TetrominoType hold, int lines) noexcept {
+    return TranspositionTable::key(board, upcoming) ^
+           mix64((static_cast<uint64_t>(hold) + 1) << 32 | static_cast<uint64_t>(lines));
+}
+
+Tetromino spawn(TetrominoType type) {
+    return createTetromino(type, {Board::SPAWN_X, Board::SPAWN_Y});
+}
+
+} // namespace
+
+AutoPlayer::AutoPlayer() : AutoPlayer(Config{}) {}
+
+AutoPlayer::AutoPlayer(const Config& config)
+    : config_(checkConfig(config))
+    , evaluator_(config.weights)
+    , pool_(config.threads)
+{
+    workers_.resize(static_cast<size_t>(pool_.size()));
+    for (auto& worker : workers_) {
+        worker.generator = std::make_unique<MoveGenerator>();
+    }
+    scored_.resize(workers_.size());
+    table_stats_.resize(workers_.size());
+    if (config_.table_megabytes > 0) {
+        table_ = std::make_unique<TranspositionTable>(config_.table_megabytes);
+    }
+    if (config_.search == Search::MCTS) {
+        mcts_ = std::make_unique<MctsSearch>(config_.mcts, evaluator_, pool_);
+    }
+
+    const auto width = static_cast<size_t>(config_.beam_width);
+    beam_.reserve(width);
+    next_beam_.reserve(width);
+    children_.resize(width);
+    for (auto& children : children_) {
+        children.reserve(128);
+    }
+    ranked_.reserve(width * 128);
+}
+
+AutoPlayer::~AutoPlayer() = default;
+
+void AutoPlayer::reset() noexcept {
+    has_plan_ = false;
+    pending_hold_ = false;
+    plan_pieces_ = -1;
+}
+
+InputAction AutoPlayer::nextAction(const GameSimulation& simulation) {
+    if (simulation.isGameOver()) return InputAction::NONE;
+
+    const int pieces = simulation.getCounters().total_pieces;
+    const bool can_hold = simulation.canHold();
+    if (pending_hold_) {
+        // The hold asked for last time has happened; the plan goes on with the piece that came out
+        pending_hold_ = false;
+        plan_pieces_ = pieces;
+        plan_can_hold_ = can_hold;
+    }
+
+    const Tetromino& current = simulation.getCurrentPiece();
+    MoveGenerator& generator = *workers_[0].generator;
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        // A new piece (or a failed plan) needs a new decision
+        if (!has_plan_ || attempt > 0 || pieces != plan_pieces_ || can_hold != plan_can_hold_) {
+            plan_ = think(simulation);
+            has_plan_ = true;
+            plan_pieces_ = pieces;
+            plan_can_hold_ = can_hold;
+        }
+        if (plan_.hold) {
+            plan_.hold = false;
+            pending_hold_ = true;
+            return InputAction::HOLD;
+        }
+        if (plan_.piece != current.getType()) continue;
+
+        // Search from where the piece is now, so gravity since the last call does not matter
+        if (generator.generate(simulation.getBoard(), current) == 0) return InputAction::NONE;
+        const int index = generator.find(plan_.position, plan_.rotation);
+        if (index < 0) continue;
+        generator.path(generator[index], path_);
+        return path_.actions[0];
+    }
+    return InputAction::HARD_DROP;
+}
+
+AutoPlayer::Decision AutoPlayer::think(const GameSimulation& simulation) {
+    const auto deadline = std::chrono::steady_clock::now() + config_.move_budget;
+    stats_.decisions++;
+
+    if (mcts_) {
+        const MctsSearch::Result result = mcts_->search(simulation, deadline, config_.use_hold);
+        stats_.rollouts += result.rollouts;
+        return Decision{result.hold, result.piece, result.position, result.rotation, result.value,
+                        static_cast<int>(queue_.pieces.size()) + config_.mcts.rollout_depth};
+    }
+
+    queue_.pieces = {simulation.getCurrentPiece().getType(), simulation.getNextPiece().getType()};
+    queue_.length = static_cast<int>(queue_.pieces.size());
+    root_piece_ = simulation.getCurrentPiece();
+    later_hold_ = config_.use_hold && simulation.getConfig().enable_hold;
+    root_hold_ = later_hold_ && simulation.canHold();
+
+    beam_.resize(1);
+    Node& root = beam_[0];
+    root.board = simulation.getBoard();
+    root.hold = simulation.getHeldPiece().getType();
+    root.next = 0;
+    root.lines = 0;
+    root.score = 0.0;
+    root.first = Decision{};
+    std::fill(scored_.begin(), scored_.end(), 0);
+    std::fill(table_stats_.begin(), table_stats_.end(), TranspositionTable::Stats{});
+
+    Decision best;
+    for (int level = 0; level < MAX_DEPTH; ++level) {
+        if (level > 0 && std::chrono::steady_clock::now() >= deadline) {
+            stats_.budget_cutoffs++;
+            break;
+        }
+
+        pool_.parallelFor(static_cast<int>(beam_.size()), [this, level](int index, int worker) {
+            expand(index, level, worker);
+        });
+
+        ranked_.clear();
+        for (size_t i = 0; i < beam_.size(); ++i) {
+            ranked_.insert(ranked_.end(), children_[i].begin(), children_[i].end());
+        }
+        if (ranked_.empty()) break;
+
+        // Best first; ties go to the earlier parent and child, whatever thread scored them
+        const size_t keep = std::min(ranked_.size(), static_cast<size_t>(config_.beam_width));
+        std::partial_sort(ranked_.begin(), ranked_.begin() + static_cast<std::ptrdiff_t>(keep), ranked_.end(),
+                          [](const Candidate& a, const Candidate& b) {
+                              if (a.score != b.score) return a.score > b.score;
+                              if (a.parent != b.parent) return a.parent < b.parent;
+                              return a.order < b.order;
+                          });
+
+        // Only the kept candidates get boards of their own
+        next_beam_.resize(keep);
+        pool_.parallelFor(static_cast<int>(keep), [this, level](int index, int /*worker*/) {
+            const Candidate& candidate = ranked_[index];
+            const Node& parent = beam_[candidate.parent];
+            Node& child = next_beam_[index];
+            child.board = parent.board;
+            Board::UndoRecord record;
+            child.board.applyPiece(Tetromino(candidate.piece, candidate.placement.position)
+                                       .withRotation(candidate.placement.rotation), record);
+            child.hold = candidate.hold;
+            child.next = candidate.next;
+            child.lines = candidate.lines;
+            child.score = candidate.score;
+            if (level == 0) {
+                child.first = Decision{candidate.held, candidate.piece, candidate.placement.position,
+                                       candidate.placement.rotation, 0.0, 0};
+            } else {
+                child.first = parent.first;
+            }
+        });
+        std::swap(beam_, next_beam_);
+
+        best = beam_[0].first;
+        best.score = beam_[0].score;
+        best.depth = level + 1;
+    }
+
+    for (size_t i = 0; i < scored_.size(); ++i) {
+        stats_.boards_scored += scored_[i];
+        stats_.table_hits += table_stats_[i].hits;
+    }
+    return best;
+}
+
+void AutoPlayer::expand(int index, int level, int worker) {
+    const Node& node = beam_[index];
+    Worker& scratch = workers_[worker];
+    children_[index].clear();
+    scratch.board = node.board;
+
+    // At the root the falling piece goes down from where it is now; everything else spawns
+    std::array<PieceChoice, 2> choices;
+    const bool hold_allowed = level == 0 ? root_hold_ : later_hold_;
+    const int count = pieceChoices(queue_, node.hold, node.next, hold_allowed, choices);
+    for (int i = 0; i < count; ++i) {
+        const Tetromino piece = level == 0 && !choices[i].held ? root_piece_ : spawn(choices[i].piece);
+        expandPiece(node, index, scratch, piece, choices[i], worker);
+    }
+}
+
+void AutoPlayer::expandPiece(const Node& node, int index, Worker& worker, const Tetromino& piece,
+                             const PieceChoice& choice, int worker_index) {
+    MoveGenerator& generator = *worker.generator;
+    if (generator.generate(worker.board, piece) == 0) return;
+
+    auto& children = children_[index];
+    TranspositionTable::Stats& table_stats = table_stats_[worker_index];
+    const TetrominoType upcoming = choice.next < queue_.length ? queue_.pieces[choice.next] : TetrominoType::NONE;
+    Board::UndoRecord record;
+    for (const Placement& placement : generator) {
+        if (!worker.board.applyPiece(generator.piece(placement), record)) continue;
+        const int lines = node.lines + record.lines_cleared;
+        double score = LOST_SCORE;
+        if (!worker.board.isGameOver()) {
+            if (!table_) {
+                score = evaluator_.evaluate(worker.board, lines);
+            } else {
+                const uint64_t key = positionKey(worker.board, upcoming, choice.hold, lines);
+                TranspositionTable::Entry entry;
+                if (table_->probe(key, entry, table_stats)) {
+                    score = entry.score;
+                } else {
+                    score = evaluator_.evaluate(worker.board, lines);
+                    table_->store(key, score, 0, table_stats);
+                }
+            }
+        }
+        worker.board.undo(record);
+        children.push_back(Candidate{score, index, static_cast<int>(children.size()), placement,
+                                     piece.getType(), choice.hold, choice.next, lines, choice.held});
+    }
+    scored_[worker_index] += static_cast<uint64_t>(generator.size());
+}
+
+} // namespace Tetris
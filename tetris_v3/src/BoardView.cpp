@@ -0,0 +1,35 @@
+#include "BoardView.h"
+
+namespace Tetris {
+
+BoardOverlayView::BoardOverlayView(const Board& board, const Tetromino& piece, bool show_ghost)
+    : board_(board), ghost_pos_(piece.getPosition()) {
+    if (!piece.isValid()) return;
+
+    piece_type_ = piece.getType();
+    piece_color_ = piece.getColorIndex();
+    const auto& geometry = piece.getGeometry();
+    buildRows(geometry, piece.getPosition(), active_rows_, active_top_);
+
+    if (show_ghost) {
+        ghost_pos_ = board.findDropPosition(piece);
+        buildRows(geometry, ghost_pos_, ghost_rows_, ghost_top_);
+    }
+}
+
+void BoardOverlayView::buildRows(const PieceGeometry& geometry, const Position& pos, PieceRows& rows, int& top) noexcept {
+    top = pos.y + geometry.min_y;
+    const int left = pos.x + geometry.min_x;
+    for (int i = 0; i + geometry.min_y <= geometry.max_y; ++i) {
+        uint32_t mask = geometry.row_masks[i + geometry.min_y];
+        // Clip cells outside the board so cellAt never reports them
+        mask = left >= 0 ? mask << left : mask >> -left;
+        rows[i] = mask & Board::FULL_ROW;
+        const int y = top + i;
+        if (y < 0 || y >= Board::HEIGHT) {
+            rows[i] = 0;
+        }
+    }
+}
+
+} // namespace Tetris
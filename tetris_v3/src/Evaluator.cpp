@@ -0,0 +1,75 @@
+#include "Evaluator.h"
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace Tetris {
+
+Evaluator::Weights Evaluator::defaultWeights() noexcept {
+    Weights weights{};
+    weights[static_cast<size_t>(Feature::TOTAL_HEIGHT)] = -0.5;
+    weights[static_cast<size_t>(Feature::MAX_HEIGHT)] = 0.0;
+    weights[static_cast<size_t>(Feature::HOLES)] = -4.0;
+    weights[static_cast<size_t>(Feature::BUMPINESS)] = -0.2;
+    weights[static_cast<size_t>(Feature::LINES_CLEARED)] = 0.8;
+    weights[static_cast<size_t>(Feature::WELLS)] = -1.0;
+    weights[static_cast<size_t>(Feature::ROW_TRANSITIONS)] = -1.0;
+    weights[static_cast<size_t>(Feature::COLUMN_TRANSITIONS)] = -1.0;
+    weights[static_cast<size_t>(Feature::COVERED_CELLS)] = -0.5;
+    weights[static_cast<size_t>(Feature::HOLE_ROWS)] = -1.0;
+    return weights;
+}
+
+Evaluator::Weights Evaluator::parseWeights(std::istream& in, const std::string& source) {
+    Weights weights{};
+    std::array<bool, FEATURE_COUNT> seen{};
+    std::string line;
+    for (int line_number = 1; std::getline(in, line); ++line_number) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string name;
+        if (!(fields >> name)) continue;
+
+        const std::string where = source + ":" + std::to_string(line_number) + ": ";
+        const auto found = std::find(FEATURE_NAMES.begin(), FEATURE_NAMES.end(), name);
+        if (found == FEATURE_NAMES.end()) {
+            throw std::runtime_error(where + "unknown feature '" + name + "'");
+        }
+        const auto index = static_cast<size_t>(found - FEATURE_NAMES.begin());
+        if (seen[index]) {
+            throw std::runtime_error(where + "feature '" + name + "' given twice");
+        }
+        double value = 0;
+        std::string rest;
+        if (!(fields >> value) || fields >> rest) {
+            throw std::runtime_error(where + "expected '" + name + " <number>'");
+        }
+        weights[index] = value;
+        seen[index] = true;
+    }
+    return weights;
+}
+
+void Evaluator::writeWeights(std::ostream& out, const Weights& weights) {
+    out << "# tetris_v3 evaluator weights: <feature> <weight>, higher scores are better\n"
+        << std::setprecision(std::numeric_limits<double>::max_digits10);
+    for (int i = 0; i < FEATURE_COUNT; ++i) {
+        out << FEATURE_NAMES[i] << ' ' << weights[i] << '\n';
+    }
+}
+
+Evaluator::Weights Evaluator::loadWeights(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) throw std::runtime_error("Cannot open weight file: " + path);
+    return parseWeights(file, path);
+}
+
+void Evaluator::saveWeights(const std::string& path, const Weights& weights) {
+    std::ofstream file(path, std::ios::trunc);
+    writeWeights(file, weights);
+    if (!file) throw std::runtime_error("Cannot write weight file: " + path);
+}
+
+} // namespace Tetris
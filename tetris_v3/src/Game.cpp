@@ -1,5 +1,6 @@
 #include "Game.h"
 #include <algorithm>
+#include <random>
 #include <thread>
 #include <iostream>
 
@@ -20,20 +21,14 @@ TetrisGame::TetrisGame() : TetrisGame(Config{}) {}
 TetrisGame::TetrisGame(const Config& config) 
     : config_(config)
     , state_(GameState::MENU)
-    , board_()
+    , simulation_(config.simulationConfig())
     , input_system_(config.input_config)
     , render_system_(config.render_config)
-    , can_hold_(true)
-    , score_(0)
-    , level_(1)
-    , total_lines_cleared_(0)
-    , lines_cleared_this_level_(0)
-    , rng_()
-    , total_pieces_generated_(0)
     , stats_()
 {
-    initializeRNG();
-    current_drop_speed_ = config_.difficulty.getDropSpeed(level_);
+    if (config_.autoplay) {
+        autoplayer_ = std::make_unique<AutoPlayer>(config_.autoplay_config);
+    }
 }
 
 TetrisGame::~TetrisGame() {
@@ -45,13 +40,7 @@ bool TetrisGame::initialize() {
         return false;
     }
     
-    resetGameState();
-    
-    // Set up board callback
-    board_.setLineClearCallback([this](int lines, int /*level*/) {
-        updateScore(lines);
-    });
-    
+    // Line clears are scored by the simulation when it locks a piece
     return true;
 }
 
@@ -81,6 +70,11 @@ int TetrisGame::run() {
         
         // Handle input
         InputState input_state = input.pollInput();
+        if (autoplayer_ && state_ == GameState::PLAYING &&
+            input_state.action != InputAction::PAUSE && input_state.action != InputAction::QUIT) {
+            // The computer player replaces the keyboard in play; pause and quit stay with the user
+            input_state = InputState(autoplayer_->nextAction(simulation_), true);
+        }
         handleInput(input_state);
         
         // Update game state
@@ -111,7 +105,7 @@ int TetrisGame::run() {
                 break;
                 
             case GameState::GAME_OVER:
-                renderer.renderGameOver(score_, level_);
+                renderer.renderGameOver(simulation_.getScore(), simulation_.getLevel());
                 break;
                 
             case GameState::HELP:
@@ -132,18 +126,56 @@ int TetrisGame::run() {
         }
     }
     
+    finishRecording();
+    return 0;
+}
+
+int TetrisGame::playReplay(const Replay& replay) {
+    if (!initialize()) {
+        return 1;
+    }
+    
+    auto& input = input_system_.getHandler();
+    ReplayPlayer player(replay, simulation_);
+    state_ = GameState::PLAYING;
+    game_start_time_ = std::chrono::steady_clock::now();
+    stats_ = DetailedStats{};
+    stats_.game_start_time = game_start_time_;
+    
+    // One simulation tick per frame paces the replay at the speed it was played
+    auto next_frame = std::chrono::steady_clock::now();
+    while (player.step()) {
+        updateStats();
+        render();
+        if (input.pollInput().action == InputAction::QUIT) {
+            break;
+        }
+        next_frame += GameSimulation::TICK_DURATION;
+        std::this_thread::sleep_until(next_frame);
+    }
+    render();
+    state_ = GameState::EXITING;
     return 0;
 }
 
 void TetrisGame::startNewGame() {
-    resetGameState();
+    finishRecording(); // Restarting abandons the previous game
+    
+    // A configured seed replays the same piece sequence every game
+    std::random_device rd;
+    const uint64_t seed = config_.seed ? *config_.seed : (static_cast<uint64_t>(rd()) << 32) | rd();
+    simulation_.newGame(seed);
+    recording_ = Replay(seed, simulation_.getConfig());
+    recording_open_ = true;
+    if (autoplayer_) {
+        autoplayer_->reset();
+    }
     state_ = GameState::PLAYING;
     game_start_time_ = std::chrono::steady_clock::now();
-    last_drop_time_ = game_start_time_;
+    tick_backlog_ = std::chrono::milliseconds(0);
     
-    generateNextPiece();
-    spawnNextPiece();
-    generateNextPiece();
+    stats_ = DetailedStats{};
+    stats_.game_start_time = game_start_time_;
 }
 
 void TetrisGame::togglePause() {
@@ -157,15 +189,28 @@ void TetrisGame::togglePause() {
 void TetrisGame::update(std::chrono::milliseconds delta_time) {
     if (state_ != GameState::PLAYING) return;
     
-    updateGameplay(delta_time);
+    // Run one simulation tick per TICK_DURATION of wall time; the remainder carries over
+    tick_backlog_ += delta_time;
+    while (tick_backlog_ >= GameSimulation::TICK_DURATION && !simulation_.isGameOver()) {
+        simulation_.tick();
+        tick_backlog_ -= GameSimulation::TICK_DURATION;
+    }
     updateStats();
+    
+    if (simulation_.isGameOver()) {
+        state_ = GameState::GAME_OVER;
+        finishRecording();
+        if (game_over_callback_) {
+            game_over_callback_(simulation_.getScore(), simulation_.getLevel());
+        }
+    }
 }
 
 void TetrisGame::render() {
     if (state_ != GameState::PLAYING) return;
     
     GameStats stats = getGameStatsForRender();
-    render_system_.getRenderer().render(board_, current_piece_, stats);
+    render_system_.getRenderer().render(simulation_.getBoard(), simulation_.getCurrentPiece(), stats);
 }
 
 void TetrisGame::handleInput(const InputState& input) {
@@ -176,37 +221,22 @@ void TetrisGame::handleInput(const InputState& input) {
             handleMenuInput(input);
             break;
         case GameState::PLAYING:
-            // Handle game actions
+            // Game actions go to the simulation; pause and quit stay here
             switch (input.action) {
-                case InputAction::MOVE_LEFT:
-                    movePiece({-1, 0});
-                    break;
-                case InputAction::MOVE_RIGHT:
-                    movePiece({1, 0});
-                    break;
-                case InputAction::SOFT_DROP:
-                    softDropPiece();
-                    break;
-                case InputAction::HARD_DROP:
-                    hardDropPiece();
-                    break;
-                case InputAction::ROTATE_CW:
-                    rotatePiece(true);
-                    break;
-                case InputAction::ROTATE_CCW:
-                    rotatePiece(false);
-                    break;
-                case InputAction::HOLD:
-                    holdPiece();
-                    break;
                 case InputAction::PAUSE:
                     togglePause();
                     break;
                 case InputAction::QUIT:
                     state_ = GameState::EXITING;
                     break;
-                default:
+                default: {
+                    // Only actions that changed the game matter for a replay
+                    const uint64_t tick = simulation_.getCounters().ticks;
+                    if (simulation_.applyAction(input.action)) {
+                        recording_.record(tick, input.action);
+                    }
                     break;
+                }
             }
             break;
         case GameState::PAUSED:
@@ -220,24 +250,6 @@ void TetrisGame::handleInput(const InputState& input) {
     }
 }
 
-void TetrisGame::updateGameplay(std::chrono::milliseconds /*delta_time*/) {
-    // Automatic piece dropping
-    if (shouldDropPiece()) {
-        if (!softDropPiece()) {
-            lockPiece();
-        }
-        last_drop_time_ = std::chrono::steady_clock::now();
-    }
-    
-    // Check for game over
-    if (checkGameOver()) {
-        state_ = GameState::GAME_OVER;
-        if (game_over_callback_) {
-            game_over_callback_(score_, level_);
-        }
-    }
-}
-
 void TetrisGame::handleMenuInput(const InputState& /*input*/) {
     // Handled in main run loop
 }
@@ -258,237 +270,19 @@ void TetrisGame::handleGameOverInput(const InputState& input) {
     }
 }
 
-bool TetrisGame::movePiece(const Position& direction) {
-    Position new_pos = current_piece_.getPosition() + direction;
-    if (board_.canPlacePiece(current_piece_, new_pos, current_piece_.getRotation())) {
-        current_piece_.setPosition(new_pos);
-        return true;
-    }
-    return false;
-}
-
-bool TetrisGame::rotatePiece(bool clockwise) {
-    Rotation new_rotation = current_piece_.getRotation();
-    if (clockwise) {
-        new_rotation = static_cast<Rotation>((static_cast<int>(new_rotation) + 1) % 4);
-    } else {
-        new_rotation = static_cast<Rotation>((static_cast<int>(new_rotation) + 3) % 4);
-    }
-    
-    // Try simple rotation first
-    if (board_.canPlacePiece(current_piece_, current_piece_.getPosition(), new_rotation)) {
-        if (clockwise) {
-            current_piece_.rotateClockwise();
-        } else {
-            current_piece_.rotateCounterClockwise();
-        }
-        return true;
-    }
-    
-    // Try wall kicks (simplified SRS)
-    std::vector<Position> kick_offsets = {{-1, 0}, {1, 0}, {0, -1}, {-1, -1}, {1, -1}};
-    for (const auto& offset : kick_offsets) {
-        Position test_pos = current_piece_.getPosition() + offset;
-        if (board_.canPlacePiece(current_piece_, test_pos, new_rotation)) {
-            current_piece_.setPosition(test_pos);
-            if (clockwise) {
-                current_piece_.rotateClockwise();
-            } else {
-                current_piece_.rotateCounterClockwise();
-            }
-            return true;
-        }
-    }
-    
-    return false;
-}
-
-int TetrisGame::hardDropPiece() {
-    Position drop_pos = board_.findDropPosition(current_piece_);
-    int drop_distance = drop_pos.y - current_piece_.getPosition().y;
-    current_piece_.setPosition(drop_pos);
-    
-    // Add hard drop points
-    score_ += drop_distance * config_.score_config.hard_drop;
-    if (score_update_callback_) {
-        score_update_callback_(score_, 0);
-    }
-    
-    lockPiece();
-    return drop_distance;
-}
-
-bool TetrisGame::softDropPiece() {
-    if (movePiece({0, 1})) {
-        score_ += config_.score_config.soft_drop;
-        if (score_update_callback_) {
-            score_update_callback_(score_, 0);
-        }
-        return true;
-    }
-    return false;
-}
-
-bool TetrisGame::holdPiece() {
-    if (!can_hold_ || !config_.enable_hold) {
-        return false;
-    }
-    
-    if (held_piece_.isValid()) {
-        // Swap current and held pieces
-        std::swap(current_piece_, held_piece_);
-        current_piece_.setPosition({Board::SPAWN_X, Board::SPAWN_Y});
-        // Reset rotation to NORTH by creating a new piece with same type
-        current_piece_ = createTetromino(current_piece_.getType(), {Board::SPAWN_X, Board::SPAWN_Y});
-    } else {
-        // Move current to held and spawn next
-        held_piece_ = current_piece_;
-        held_piece_.setPosition({0, 0});
-        spawnNextPiece();
-        generateNextPiece();
-    }
-    
-    can_hold_ = false;
-    return true;
-}
-
-void TetrisGame::lockPiece() {
-    board_.placePiece(current_piece_);
-    
-    int lines_cleared = board_.clearLines();
-    if (lines_cleared > 0) {
-        total_lines_cleared_ += lines_cleared;
-        lines_cleared_this_level_ += lines_cleared;
-        
-        updateScore(lines_cleared);
-        updateLevel();
-        
-        if (lines_cleared == 4) {
-            stats_.tetris_count++;
-        }
-    }
-    
-    can_hold_ = true;
-    
-    if (!spawnNextPiece()) {
-        state_ = GameState::GAME_OVER;
-        return;
-    }
-    
-    generateNextPiece();
-}
-
-bool TetrisGame::spawnNextPiece() {
-    current_piece_ = next_piece_;
-    current_piece_.setPosition({Board::SPAWN_X, Board::SPAWN_Y});
-    
-    if (!board_.canPlacePiece(current_piece_)) {
-        return false; // Game over
-    }
-    
-    total_pieces_generated_++;
-    stats_.total_pieces++;
-    
-    if (static_cast<size_t>(current_piece_.getType()) < stats_.piece_counts.size()) {
-        stats_.piece_counts[static_cast<size_t>(current_piece_.getType())]++;
-    }
-    
-    return true;
-}
-
-void TetrisGame::generateNextPiece() {
-    if (config_.enable_7_bag) {
-        if (piece_bag_.empty()) {
-            fillPieceBag();
-        }
-        next_piece_ = createTetromino(piece_bag_.front(), {0, 0});
-        piece_bag_.pop();
-    } else {
-        next_piece_ = createRandomTetromino({0, 0});
-    }
-}
-
-void TetrisGame::fillPieceBag() {
-    std::vector<TetrominoType> pieces = {
-        TetrominoType::I, TetrominoType::O, TetrominoType::T, TetrominoType::S,
-        TetrominoType::Z, TetrominoType::J, TetrominoType::L
-    };
-    
-    std::shuffle(pieces.begin(), pieces.end(), rng_);
-    
-    for (auto piece : pieces) {
-        piece_bag_.push(piece);
-    }
-}
-
-void TetrisGame::updateScore(int lines_cleared) {
-    int line_score = config_.score_config.calculateLineScore(lines_cleared, level_);
-    score_ += line_score;
-    
-    if (score_update_callback_) {
-        score_update_callback_(score_, lines_cleared);
-    }
-}
-
-void TetrisGame::updateLevel() {
-    int new_level = 1 + (total_lines_cleared_ / config_.difficulty.lines_per_level);
-    if (new_level > level_ && new_level <= config_.difficulty.max_level) {
-        level_ = new_level;
-        updateDropSpeed();
-        lines_cleared_this_level_ = 0;
-        
-        if (level_up_callback_) {
-            level_up_callback_(level_);
-        }
-    }
-}
-
-void TetrisGame::updateDropSpeed() {
-    current_drop_speed_ = config_.difficulty.getDropSpeed(level_);
-}
-
-bool TetrisGame::shouldDropPiece() const {
-    auto current_time = std::chrono::steady_clock::now();
-    auto time_since_drop = std::chrono::duration_cast<std::chrono::milliseconds>(
-        current_time - last_drop_time_
-    );
-    return time_since_drop >= current_drop_speed_;
-}
-
-void TetrisGame::resetGameState() {
-    board_.reset();
-    score_ = 0;
-    level_ = 1;
-    total_lines_cleared_ = 0;
-    lines_cleared_this_level_ = 0;
-    can_hold_ = true;
-    total_pieces_generated_ = 0;
-    
-    current_piece_.reset();
-    next_piece_.reset();
-    held_piece_.reset();
-    
-    // Clear piece bag
-    while (!piece_bag_.empty()) {
-        piece_bag_.pop();
-    }
-    
-    updateDropSpeed();
-    
-    // Reset stats
-    stats_ = DetailedStats{};
-    stats_.game_start_time = std::chrono::steady_clock::now();
-}
-
 void TetrisGame::updateStats() {
     auto current_time = std::chrono::steady_clock::now();
     stats_.total_play_time = std::chrono::duration_cast<std::chrono::milliseconds>(
         current_time - stats_.game_start_time
     );
     
-    stats_.score = score_;
-    stats_.level = level_;
-    stats_.lines_cleared = total_lines_cleared_;
+    const auto& counters = simulation_.getCounters();
+    stats_.score = simulation_.getScore();
+    stats_.level = simulation_.getLevel();
+    stats_.lines_cleared = simulation_.getLinesCleared();
+    stats_.total_pieces = counters.total_pieces;
+    stats_.piece_counts = counters.piece_counts;
+    stats_.tetris_count = counters.tetris_count;
     
     if (stats_.total_play_time.count() > 0) {
         stats_.pieces_per_second = static_cast<double>(stats_.total_pieces) / 
@@ -498,23 +292,23 @@ void TetrisGame::updateStats() {
 
 GameStats TetrisGame::getGameStatsForRender() const {
     GameStats stats;
-    stats.score = score_;
-    stats.level = level_;
-    stats.lines_cleared = total_lines_cleared_;
-    stats.total_pieces = stats_.total_pieces;
-    stats.next_piece = next_piece_.getType();
-    stats.held_piece = held_piece_.getType();
-    stats.can_hold = can_hold_;
+    stats.score = simulation_.getScore();
+    stats.level = simulation_.getLevel();
+    stats.lines_cleared = simulation_.getLinesCleared();
+    stats.total_pieces = simulation_.getCounters().total_pieces;
+    stats.next_piece = simulation_.getNextPiece().getType();
+    stats.held_piece = simulation_.getHeldPiece().getType();
+    stats.can_hold = simulation_.canHold();
     return stats;
 }
 
-bool TetrisGame::checkGameOver() {
-    return board_.isGameOver();
-}
-
-void TetrisGame::initializeRNG() {
-    std::random_device rd;
-    rng_.seed(rd());
+void TetrisGame::finishRecording() {
+    if (!recording_open_) return;
+    recording_open_ = false;
+    recording_.finish(simulation_);
+    if (!config_.record_path.empty()) {
+        recording_.save(config_.record_path);
+    }
 }
 
 TetrisGame::DetailedStats TetrisGame::getDetailedStats() const {
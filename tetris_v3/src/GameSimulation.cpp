@@ -0,0 +1,228 @@
+#include "GameSimulation.h"
+#include <algorithm>
+
+namespace Tetris {
+
+GameSimulation::GameSimulation() : GameSimulation(Config{}) {}
+
+GameSimulation::GameSimulation(const Config& config) : config_(config) {
+    newGame(0);
+}
+
+void GameSimulation::newGame(uint64_t seed) {
+    board_.reset();
+    seed_ = seed;
+    rng_.seed(seed);
+    // Empty the piece bag so the first piece starts a fresh one
+    bag_index_ = piece_bag_.size();
+
+    score_ = 0;
+    level_ = 1;
+    total_lines_cleared_ = 0;
+    can_hold_ = true;
+    game_over_ = false;
+    counters_ = Counters{};
+    held_piece_.reset();
+
+    updateLevel();
+    ticks_since_drop_ = 0;
+
+    generateNextPiece();
+    spawnNextPiece();
+    generateNextPiece();
+}
+
+bool GameSimulation::applyAction(InputAction action) {
+    if (game_over_) return false;
+
+    switch (action) {
+        case InputAction::MOVE_LEFT:
+            return movePiece({-1, 0});
+        case InputAction::MOVE_RIGHT:
+            return movePiece({1, 0});
+        case InputAction::SOFT_DROP:
+            return softDropPiece();
+        case InputAction::HARD_DROP:
+            hardDropPiece();
+            return true;
+        case InputAction::ROTATE_CW:
+            return rotatePiece(true);
+        case InputAction::ROTATE_CCW:
+            return rotatePiece(false);
+        case InputAction::HOLD:
+            return holdPiece();
+        default:
+            return false;
+    }
+}
+
+void GameSimulation::tick() {
+    if (game_over_) return;
+
+    counters_.ticks++;
+    if (++ticks_since_drop_ < gravity_ticks_) return;
+
+    // Gravity moves the piece without awarding soft drop points
+    ticks_since_drop_ = 0;
+    if (!movePiece({0, 1})) {
+        lockPiece();
+    }
+}
+
+bool GameSimulation::movePiece(const Position& direction) {
+    Position new_pos = current_piece_.getPosition() + direction;
+    if (board_.canPlacePiece(current_piece_, new_pos, current_piece_.getRotation())) {
+        current_piece_.setPosition(new_pos);
+        return true;
+    }
+    return false;
+}
+
+bool GameSimulation::rotatePiece(bool clockwise) {
+    Rotation new_rotation = current_piece_.getRotation();
+    if (clockwise) {
+        new_rotation = static_cast<Rotation>((static_cast<int>(new_rotation) + 1) % 4);
+    } else {
+        new_rotation = static_cast<Rotation>((static_cast<int>(new_rotation) + 3) % 4);
+    }
+
+    // Try simple rotation first, then wall kicks (simplified SRS)
+    const auto rotated_pos = board_.findRotationPosition(current_piece_, new_rotation);
+    if (!rotated_pos) {
+        return false;
+    }
+
+    current_piece_.setPosition(*rotated_pos);
+    if (clockwise) {
+        current_piece_.rotateClockwise();
+    } else {
+        current_piece_.rotateCounterClockwise();
+    }
+    return true;
+}
+
+int GameSimulation::hardDropPiece() {
+    Position drop_pos = board_.findDropPosition(current_piece_);
+    int drop_distance = drop_pos.y - current_piece_.getPosition().y;
+    current_piece_.setPosition(drop_pos);
+
+    addScore(drop_distance * config_.score_config.hard_drop, 0);
+    lockPiece();
+    return drop_distance;
+}
+
+bool GameSimulation::softDropPiece() {
+    if (movePiece({0, 1})) {
+        addScore(config_.score_config.soft_drop, 0);
+        return true;
+    }
+    return false;
+}
+
+bool GameSimulation::holdPiece() {
+    if (!can_hold_ || !config_.enable_hold) {
+        return false;
+    }
+
+    if (held_piece_.isValid()) {
+        // Swap current and held pieces, the returning piece starting at spawn facing north
+        std::swap(current_piece_, held_piece_);
+        current_piece_ = createTetromino(current_piece_.getType(), {Board::SPAWN_X, Board::SPAWN_Y});
+        held_piece_.setPosition({0, 0});
+    } else {
+        // Move current to held and spawn next
+        held_piece_ = current_piece_;
+        held_piece_.setPosition({0, 0});
+        if (!spawnNextPiece()) {
+            game_over_ = true;
+            return true;
+        }
+        generateNextPiece();
+    }
+
+    can_hold_ = false;
+    return true;
+}
+
+void GameSimulation::lockPiece() {
+    board_.placePiece(current_piece_);
+
+    const int lines_cleared = board_.clearLines();
+    if (lines_cleared > 0) {
+        total_lines_cleared_ += lines_cleared;
+        // Scored at the level the lines were cleared on
+        addScore(config_.score_config.calculateLineScore(lines_cleared, level_), lines_cleared);
+        updateLevel();
+
+        if (lines_cleared == 4) {
+            counters_.tetris_count++;
+        }
+    }
+
+    can_hold_ = true;
+    ticks_since_drop_ = 0;
+
+    if (board_.isGameOver() || !spawnNextPiece()) {
+        game_over_ = true;
+        return;
+    }
+    generateNextPiece();
+}
+
+bool GameSimulation::spawnNextPiece() {
+    current_piece_ = next_piece_;
+    current_piece_.setPosition({Board::SPAWN_X, Board::SPAWN_Y});
+
+    if (!board_.canPlacePiece(current_piece_)) {
+        return false; // Game over
+    }
+
+    counters_.total_pieces++;
+    counters_.piece_counts[static_cast<size_t>(current_piece_.getType())]++;
+    return true;
+}
+
+void GameSimulation::generateNextPiece() {
+    if (config_.enable_7_bag) {
+        if (bag_index_ >= piece_bag_.size()) {
+            fillPieceBag();
+        }
+        next_piece_ = createTetromino(piece_bag_[bag_index_++], {0, 0});
+    } else {
+        next_piece_ = createRandomTetromino(rng_, {0, 0});
+    }
+}
+
+void GameSimulation::fillPieceBag() {
+    piece_bag_ = {
+        TetrominoType::I, TetrominoType::O, TetrominoType::T, TetrominoType::S,
+        TetrominoType::Z, TetrominoType::J, TetrominoType::L
+    };
+
+    rng_.shuffle(piece_bag_);
+    bag_index_ = 0;
+}
+
+void GameSimulation::addScore(int points, int lines_cleared) {
+    score_ += points;
+    if (score_update_callback_) {
+        score_update_callback_(score_, lines_cleared);
+    }
+}
+
+void GameSimulation::updateLevel() {
+    const int new_level = std::min(1 + total_lines_cleared_ / config_.difficulty.lines_per_level,
+                                   config_.difficulty.max_level);
+    const bool level_up = new_level > level_;
+    level_ = std::max(level_, new_level);
+
+    // Gravity interval: the level's drop speed rounded up to whole ticks
+    const auto drop_speed = config_.difficulty.getDropSpeed(level_);
+    gravity_ticks_ = std::max<int>(1, static_cast<int>((drop_speed + TICK_DURATION - std::chrono::milliseconds(1)) / TICK_DURATION));
+
+    if (level_up && level_up_callback_) {
+        level_up_callback_(level_);
+    }
+}
+
+} // namespace Tetris
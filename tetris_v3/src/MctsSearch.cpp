@@ -0,0 +1,256 @@
+#include "MctsSearch.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace Tetris {
+
+namespace {
+
+const MctsSearch::Config& checkConfig(const MctsSearch::Config& config) {
+    if (config.max_nodes < 2) {
+        throw std::invalid_argument("MCTS node pool must hold at least 2 nodes");
+    }
+    if (config.rollout_depth < 0) {
+        throw std::invalid_argument("MCTS rollout depth must not be negative");
+    }
+    return config;
+}
+
+Tetromino spawn(TetrominoType type) {
+    return createTetromino(type, {Board::SPAWN_X, Board::SPAWN_Y});
+}
+
+} // namespace
+
+MctsSearch::MctsSearch(const Config& config, const Evaluator& evaluator, ThreadPool& pool)
+    : config_(checkConfig(config))
+    , evaluator_(evaluator)
+    , pool_(pool)
+    , nodes_(std::make_unique<Node[]>(static_cast<size_t>(config.max_nodes)))
+{
+    workers_.resize(static_cast<size_t>(pool_.size()));
+    for (auto& worker : workers_) {
+        worker.generator = std::make_unique<MoveGenerator>();
+        worker.children.reserve(256);
+    }
+}
+
+MctsSearch::~MctsSearch() = default;
+
+MctsSearch::Result MctsSearch::search(const GameSimulation& simulation, std::chrono::steady_clock::time_point deadline,
+                                      bool use_hold) {
+    root_board_ = simulation.getBoard();
+    root_piece_ = simulation.getCurrentPiece();
+    queue_.pieces = {simulation.getCurrentPiece().getType(), simulation.getNextPiece().getType()};
+    queue_.length = static_cast<int>(queue_.pieces.size());
+    use_hold_ = use_hold && simulation.getConfig().enable_hold;
+    root_hold_ = use_hold_ && simulation.canHold();
+
+    Node& root = nodes_[0];
+    root.visits.store(0, std::memory_order_relaxed);
+    root.value.store(0, std::memory_order_relaxed);
+    root.state.store(UNEXPANDED, std::memory_order_relaxed);
+    root.child_count = 0;
+    root.hold = simulation.getHeldPiece().getType();
+    root.next = 0;
+    root.lines = 0;
+    root.lost = false;
+    node_count_.store(1, std::memory_order_relaxed);
+    rollouts_.store(0, std::memory_order_relaxed);
+    stop_.store(false, std::memory_order_relaxed);
+
+    // Each search gets fresh rollout streams, one per worker
+    for (size_t w = 0; w < workers_.size(); ++w) {
+        workers_[w].rng = Pcg32(config_.seed + searches_, static_cast<uint64_t>(w));
+    }
+    searches_++;
+
+    pool_.parallelFor(pool_.size(), [this, deadline](int /*index*/, int worker) {
+        simulate(worker, deadline);
+    });
+
+    Result result;
+    result.rollouts = rollouts_.load(std::memory_order_relaxed);
+    if (config_.max_rollouts) result.rollouts = std::min(result.rollouts, config_.max_rollouts);
+    result.nodes = std::min(node_count_.load(std::memory_order_relaxed), config_.max_nodes);
+    if (root.state.load(std::memory_order_acquire) != EXPANDED || root.child_count == 0) {
+        return result;
+    }
+
+    // Most visits wins; a tie goes to the better mean, then to the statically better move
+    const Node* best = nullptr;
+    double best_mean = 0.0;
+    for (int i = 0; i < root.child_count; ++i) {
+        const Node& child = nodes_[root.first_child + i];
+        const int visits = child.visits.load(std::memory_order_relaxed);
+        const double mean = visits ? static_cast<double>(child.value.load(std::memory_order_relaxed)) / VALUE_SCALE / visits
+                                   : -std::numeric_limits<double>::max();
+        const int best_visits = best ? best->visits.load(std::memory_order_relaxed) : -1;
+        if (visits > best_visits || (visits == best_visits && mean > best_mean)) {
+            best = &child;
+            best_mean = mean;
+        }
+    }
+    result.hold = best->held;
+    result.piece = best->piece;
+    result.position = best->placement.position;
+    result.rotation = best->placement.rotation;
+    result.visits = best->visits.load(std::memory_order_relaxed);
+    result.value = best_mean;
+    return result;
+}
+
+void MctsSearch::simulate(int worker_index, std::chrono::steady_clock::time_point deadline) {
+    Worker& worker = workers_[worker_index];
+    Board::UndoRecord record;
+    do {
+        const uint64_t claimed = rollouts_.fetch_add(1, std::memory_order_relaxed);
+        if (config_.max_rollouts && claimed >= config_.max_rollouts) {
+            stop_.store(true, std::memory_order_relaxed);
+            break;
+        }
+
+        // Selection: walk down by UCT, charging a virtual loss to every node passed
+        worker.board = root_board_;
+        int depth = 0;
+        int index = 0;
+        bool expanded_parent = false;
+        double value;
+        for (;;) {
+            Node& node = nodes_[index];
+            node.visits.fetch_add(1, std::memory_order_relaxed);
+            addValue(node, -config_.virtual_loss);
+            worker.path[depth++] = index;
+
+            if (node.lost) {
+                value = LOST_VALUE;
+                break;
+            }
+            if (expanded_parent) {
+                // A fresh child of the node this simulation expanded: evaluate it by rollout
+                value = rollout(node, worker);
+                break;
+            }
+
+            int state = node.state.load(std::memory_order_acquire);
+            if (state == UNEXPANDED && node.state.compare_exchange_strong(state, EXPANDING, std::memory_order_acq_rel)) {
+                expand(node, index, worker);
+                state = EXPANDED;
+                expanded_parent = true;
+            }
+            // Being expanded by another thread, out of known pieces, or out of nodes: roll out from here
+            if (state != EXPANDED || node.child_count == 0 || depth == MAX_PATH) {
+                value = rollout(node, worker);
+                break;
+            }
+
+            index = select(node);
+            const Node& child = nodes_[index];
+            worker.board.applyPiece(Tetromino(child.piece, child.placement.position).withRotation(child.placement.rotation),
+                                    record);
+        }
+
+        // Backpropagation: replace each virtual loss with the real value
+        for (int i = 0; i < depth; ++i) {
+            addValue(nodes_[worker.path[i]], value + config_.virtual_loss);
+        }
+    } while (!stop_.load(std::memory_order_relaxed) && std::chrono::steady_clock::now() < deadline);
+}
+
+bool MctsSearch::expand(Node& node, int index, Worker& worker) {
+    MoveGenerator& generator = *worker.generator;
+    auto& children = worker.children;
+    children.clear();
+
+    std::array<PieceChoice, 2> choices;
+    const int choice_count = pieceChoices(queue_, node.hold, node.next, index == 0 ? root_hold_ : use_hold_, choices);
+    Board::UndoRecord record;
+    for (int c = 0; c < choice_count; ++c) {
+        const Tetromino piece = index == 0 && !choices[c].held ? root_piece_ : spawn(choices[c].piece);
+        if (generator.generate(worker.board, piece) == 0) continue;
+        for (const Placement& placement : generator) {
+            if (!worker.board.applyPiece(generator.piece(placement), record)) continue;
+            const int lines = node.lines + record.lines_cleared;
+            const bool lost = worker.board.isGameOver();
+            const double score = lost ? LOST_VALUE : evaluator_.evaluate(worker.board, lines);
+            worker.board.undo(record);
+            children.push_back(Child{score, static_cast<int>(children.size()), placement, choices[c], lines, lost});
+        }
+    }
+    std::sort(children.begin(), children.end(), [](const Child& a, const Child& b) {
+        return a.score != b.score ? a.score > b.score : a.order < b.order;
+    });
+
+    const int count = static_cast<int>(children.size());
+    const int first = count ? node_count_.fetch_add(count, std::memory_order_relaxed) : 0;
+    if (count == 0 || first + count > config_.max_nodes) {
+        node.child_count = 0;
+        node.state.store(EXPANDED, std::memory_order_release);
+        return false;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        const Child& source = children[i];
+        Node& child = nodes_[first + i];
+        child.visits.store(0, std::memory_order_relaxed);
+        child.value.store(0, std::memory_order_relaxed);
+        child.state.store(UNEXPANDED, std::memory_order_relaxed);
+        child.first_child = 0;
+        child.child_count = 0;
+        child.placement = source.placement;
+        child.piece = source.choice.piece;
+        child.hold = source.choice.hold;
+        child.next = source.choice.next;
+        child.lines = source.lines;
+        child.held = source.choice.held;
+        child.lost = source.lost;
+    }
+    node.first_child = first;
+    node.child_count = count;
+    node.state.store(EXPANDED, std::memory_order_release);
+    return true;
+}
+
+double MctsSearch::rollout(const Node& node, Worker& worker) {
+    MoveGenerator& generator = *worker.generator;
+    Board& board = worker.rollout;
+    board = worker.board;
+
+    // Known pieces the tree has not placed come first, then random ones; each goes where it scores best
+    int lines = node.lines;
+    int next = node.next;
+    const int pieces = queue_.length - std::min(next, queue_.length) + config_.rollout_depth;
+    Board::UndoRecord record;
+    for (int i = 0; i < pieces; ++i) {
+        const TetrominoType type = next < queue_.length ? queue_.pieces[next++]
+                                                        : static_cast<TetrominoType>(worker.rng.bounded(PIECE_TYPE_COUNT));
+        if (generator.generate(board, spawn(type)) == 0) return LOST_VALUE;
+
+        board.applyPiece(generator.piece(generator[bestPlacement(board, generator, evaluator_)]), record);
+        lines += record.lines_cleared;
+        if (board.isGameOver()) return LOST_VALUE;
+    }
+    return evaluator_.evaluate(board, lines);
+}
+
+int MctsSearch::select(const Node& node) const noexcept {
+    const double log_visits = std::log(std::max(1, node.visits.load(std::memory_order_relaxed)));
+    int best = node.first_child;
+    double best_uct = -std::numeric_limits<double>::max();
+    for (int i = node.first_child; i < node.first_child + node.child_count; ++i) {
+        const Node& child = nodes_[i];
+        const int visits = child.visits.load(std::memory_order_relaxed);
+        if (visits == 0) return i;  // Children are in static order, so the best unvisited one comes first
+        const double mean = static_cast<double>(child.value.load(std::memory_order_relaxed)) / VALUE_SCALE / visits;
+        const double uct = mean + config_.exploration * std::sqrt(log_visits / visits);
+        if (uct > best_uct) {
+            best_uct = uct;
+            best = i;
+        }
+    }
+    return best;
+}
+
+} // namespace Tetris
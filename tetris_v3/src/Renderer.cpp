@@ -1,4 +1,5 @@
 #include "Renderer.h"
+#include "BoardView.h"
 #include <iostream>
 #include <stdexcept>
 #include <string>
@@ -72,12 +73,7 @@ void ConsoleRenderer::refresh() {
 void ConsoleRenderer::render(const Board& board, const Tetromino& current_piece, const GameStats& stats) {
     if (!initialized_) return;
 
-    Board render_board = board;
-    if (config_.show_ghost_piece && current_piece.isValid()) {
-        render_board = board.getPreviewBoard(current_piece);
-    }
-
-    renderBoard(render_board, current_piece);
+    renderBoard(board, current_piece);
     renderStats(stats);
     
     // Flush output buffer
@@ -90,33 +86,13 @@ void ConsoleRenderer::renderBoard(const Board& board, const Tetromino& current_p
     const auto board_pos = getBoardRenderPosition();
     renderBoardFrame();
 
-    // Draw the board state
-    const auto& grid = board.getGrid();
+    // Board, active piece and ghost are read through one overlay view; nothing is copied
+    const BoardOverlayView view(board, current_piece, config_.show_ghost_piece);
+    const int cell_width = config_.double_width ? 2 : 1;
     for (int y = 0; y < Board::HEIGHT; ++y) {
-        for (int x = 0; x < Board::WIDTH; ++x) {
-            renderCell(grid[y][x], board_pos.x + x * (config_.double_width ? 2 : 1), board_pos.y + y);
-        }
-    }
-
-    // Draw the current piece
-    if (current_piece.isValid()) {
-        const auto& piece_pos = current_piece.getPosition();
-        const auto& shape = current_piece.getCurrentShape();
-        const Color piece_color = getPieceColor(current_piece.getType());
-
-        for (int y = 0; y < 4; ++y) {
-            for (int x = 0; x < 4; ++x) {
-                if (shape[y][x]) {
-                    int board_x = piece_pos.x + x;
-                    int board_y = piece_pos.y + y;
-                    if (board_x >= 0 && board_x < Board::WIDTH && board_y >= 0 && board_y < Board::HEIGHT) {
-                        setCursorPosition(board_pos.x + board_x * (config_.double_width ? 2 : 1), board_pos.y + board_y);
-                        setTextColor(piece_color);
-                        printText(config_.double_width ? "[]" : "#");
-                    }
-                }
-            }
-        }
+        view.forEachCell(y, [&](int x, const ViewCell& cell) {
+            renderCell(view, cell, board_pos.x + x * cell_width, board_pos.y + y);
+        });
     }
     resetColors();
 }
@@ -369,17 +345,24 @@ void ConsoleRenderer::printTextAt(int x, int y, const std::string& text) {
     printText(text);
 }
 
-void ConsoleRenderer::renderCell(const Cell& cell, int x, int y, bool /*show_ghost*/) {
+void ConsoleRenderer::renderCell(const BoardOverlayView& view, const ViewCell& cell, int x, int y) {
     setCursorPosition(x, y);
-    if (cell.occupied) {
-        setTextColor(getPieceColor(static_cast<TetrominoType>(cell.color - 1)));
-        printText(config_.double_width ? "[]" : "#");
-    } else if (cell.color != 0) { // Ghost piece
-        setTextColor(Color::GRAY);
-        printText(config_.double_width ? "<>" : "x");
-    }
-    else {
-        printText(config_.double_width ? "  " : " ");
+    switch (cell.layer) {
+        case CellLayer::LOCKED:
+            setTextColor(getPieceColor(static_cast<TetrominoType>(cell.color - 1)));
+            printText(config_.double_width ? "[]" : "#");
+            break;
+        case CellLayer::ACTIVE:
+            setTextColor(getPieceColor(view.getPieceType()));
+            printText(config_.double_width ? "[]" : "#");
+            break;
+        case CellLayer::GHOST:
+            setTextColor(Color::GRAY);
+            printText(config_.double_width ? "<>" : "x");
+            break;
+        case CellLayer::EMPTY:
+            printText(config_.double_width ? "  " : " ");
+            break;
     }
 }
 
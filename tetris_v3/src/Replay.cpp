@@ -0,0 +1,174 @@
+#include "Replay.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace Tetris {
+
+namespace {
+
+constexpr int ACTION_BITS = 4;
+static_assert(static_cast<int>(InputAction::RESTART) < (1 << ACTION_BITS), "actions must fit the event's low bits");
+
+void writeVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+/**
+ * @brief Bounds-checked reader over encoded replay bytes
+ */
+class ByteReader {
+public:
+    explicit ByteReader(const std::vector<uint8_t>& data) : data_(data) {}
+
+    uint8_t byte() {
+        if (pos_ >= data_.size()) throw std::runtime_error("Replay data is truncated");
+        return data_[pos_++];
+    }
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const uint8_t b = byte();
+            value |= static_cast<uint64_t>(b & 0x7f) << shift;
+            if (!(b & 0x80)) return value;
+        }
+        throw std::runtime_error("Replay varint is too long");
+    }
+
+    int count() {
+        const uint64_t value = varint();
+        if (value > static_cast<uint64_t>(INT32_MAX)) throw std::runtime_error("Replay counter is out of range");
+        return static_cast<int>(value);
+    }
+
+    [[nodiscard]] bool atEnd() const noexcept { return pos_ == data_.size(); }
+
+private:
+    const std::vector<uint8_t>& data_;
+    size_t pos_{0};
+};
+
+} // namespace
+
+Replay::Replay(uint64_t seed, const GameSimulation::Config& config)
+    : seed_(seed), enable_7_bag_(config.enable_7_bag), enable_hold_(config.enable_hold) {}
+
+void Replay::record(uint64_t tick, InputAction action) {
+    if (!events_.empty() && tick < events_.back().tick) {
+        throw std::invalid_argument("Replay events must be recorded in tick order");
+    }
+    events_.push_back({tick, action});
+}
+
+GameSimulation::Config Replay::configure(GameSimulation::Config config) const noexcept {
+    config.enable_7_bag = enable_7_bag_;
+    config.enable_hold = enable_hold_;
+    return config;
+}
+
+std::vector<uint8_t> Replay::encode() const {
+    std::vector<uint8_t> out(MAGIC.begin(), MAGIC.end());
+    out.reserve(out.size() + 16 + events_.size() * 2);
+    out.push_back(VERSION);
+    out.push_back(static_cast<uint8_t>((enable_7_bag_ ? 1 : 0) | (enable_hold_ ? 2 : 0)));
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<uint8_t>(seed_ >> (8 * i)));
+    }
+
+    writeVarint(out, events_.size());
+    uint64_t tick = 0;
+    for (const auto& event : events_) {
+        writeVarint(out, ((event.tick - tick) << ACTION_BITS) | static_cast<uint64_t>(event.action));
+        tick = event.tick;
+    }
+    writeVarint(out, result_.ticks - tick);
+    writeVarint(out, static_cast<uint64_t>(result_.score));
+    writeVarint(out, static_cast<uint64_t>(result_.lines_cleared));
+    writeVarint(out, static_cast<uint64_t>(result_.total_pieces));
+    return out;
+}
+
+Replay Replay::decode(const std::vector<uint8_t>& data) {
+    ByteReader reader(data);
+    for (const char c : MAGIC) {
+        if (reader.byte() != static_cast<uint8_t>(c)) throw std::runtime_error("Not a replay file");
+    }
+    if (reader.byte() != VERSION) throw std::runtime_error("Unsupported replay version");
+
+    Replay replay;
+    const uint8_t flags = reader.byte();
+    replay.enable_7_bag_ = flags & 1;
+    replay.enable_hold_ = flags & 2;
+    for (int i = 0; i < 8; ++i) {
+        replay.seed_ |= static_cast<uint64_t>(reader.byte()) << (8 * i);
+    }
+
+    const int count = reader.count();
+    replay.events_.reserve(static_cast<size_t>(std::min(count, static_cast<int>(data.size()))));
+    uint64_t tick = 0;
+    for (int i = 0; i < count; ++i) {
+        const uint64_t packed = reader.varint();
+        const auto action = static_cast<uint8_t>(packed & ((1u << ACTION_BITS) - 1));
+        if (action > static_cast<uint8_t>(InputAction::RESTART)) throw std::runtime_error("Replay has an unknown action");
+        tick += packed >> ACTION_BITS;
+        replay.events_.push_back({tick, static_cast<InputAction>(action)});
+    }
+    replay.result_.ticks = tick + reader.varint();
+    replay.result_.score = reader.count();
+    replay.result_.lines_cleared = reader.count();
+    replay.result_.total_pieces = reader.count();
+    if (!reader.atEnd()) throw std::runtime_error("Replay has trailing data");
+    return replay;
+}
+
+void Replay::save(const std::string& path) const {
+    const std::vector<uint8_t> bytes = encode();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!file) throw std::runtime_error("Cannot write replay file: " + path);
+}
+
+Replay Replay::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) throw std::runtime_error("Cannot open replay file: " + path);
+    const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return decode(bytes);
+}
+
+ReplayPlayer::ReplayPlayer(const Replay& replay, GameSimulation& sim) : replay_(replay), sim_(sim) {
+    sim_.setConfig(replay_.configure(sim_.getConfig()));
+    sim_.newGame(replay_.getSeed());
+}
+
+void ReplayPlayer::applyDueEvents() {
+    const auto& events = replay_.getEvents();
+    const uint64_t now = sim_.getCounters().ticks;
+    while (next_event_ < events.size() && events[next_event_].tick == now) {
+        sim_.applyAction(events[next_event_++].action);
+    }
+}
+
+bool ReplayPlayer::step() {
+    if (finished_) return false;
+
+    applyDueEvents();
+    if (sim_.getCounters().ticks >= replay_.getResult().ticks || sim_.isGameOver()) {
+        finished_ = true;
+        return false;
+    }
+    sim_.tick();
+    return true;
+}
+
+void ReplayPlayer::runToEnd() {
+    while (step()) {
+    }
+}
+
+} // namespace Tetris
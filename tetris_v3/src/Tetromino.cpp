@@ -4,9 +4,6 @@
 
 namespace Tetris {
 
-// Static member initialization
-const std::array<Tetromino::ShapeArray, 7> Tetromino::PIECE_SHAPES = Tetromino::initializePieceShapes();
-
 Tetromino::Tetromino(TetrominoType type, const Position& start_pos)
     : type_(type), position_(start_pos), rotation_(Rotation::NORTH) {
     if (type_ >= TetrominoType::NONE) {
@@ -23,12 +20,16 @@ void Tetromino::rotateCounterClockwise() noexcept {
 }
 
 const Tetromino::BlockGrid& Tetromino::getCurrentShape() const noexcept {
+    return getShape(rotation_);
+}
+
+const Tetromino::BlockGrid& Tetromino::getShape(Rotation rot) const noexcept {
     if (!isValid()) {
         // Return an empty grid for NONE type
         static const BlockGrid empty_grid{};
         return empty_grid;
     }
-    return getShapeArray(type_)[static_cast<size_t>(rotation_)];
+    return PIECE_BLOCK_GRIDS[static_cast<size_t>(type_)][static_cast<size_t>(rot)];
 }
 
 std::vector<Position> Tetromino::getOccupiedPositions() const {
@@ -41,13 +42,8 @@ std::vector<Position> Tetromino::getOccupiedPositions(Rotation rot) const {
     }
     std::vector<Position> positions;
     positions.reserve(4);
-    const auto& shape = getShapeArray(type_)[static_cast<size_t>(rot)];
-    for (int y = 0; y < 4; ++y) {
-        for (int x = 0; x < 4; ++x) {
-            if (shape[y][x]) {
-                positions.emplace_back(x, y);
-            }
-        }
+    for (const auto& cell : getGeometry(rot).cells) {
+        positions.emplace_back(cell.x, cell.y);
     }
     return positions;
 }
@@ -56,17 +52,8 @@ Position Tetromino::getBoundingBox() const noexcept {
     if (!isValid()) {
         return {0, 0};
     }
-    int max_x = 0, max_y = 0;
-    const auto& shape = getCurrentShape();
-    for (int y = 0; y < 4; ++y) {
-        for (int x = 0; x < 4; ++x) {
-            if (shape[y][x]) {
-                if (x > max_x) max_x = x;
-                if (y > max_y) max_y = y;
-            }
-        }
-    }
-    return {max_x + 1, max_y + 1};
+    const auto& geometry = getGeometry();
+    return {geometry.max_x + 1, geometry.max_y + 1};
 }
 
 Tetromino Tetromino::withRotation(Rotation rot) const {
@@ -85,9 +72,7 @@ uint8_t Tetromino::getColorIndex() const noexcept {
     if (!isValid()) {
         return 0; // 0 for empty/none
     }
-    // Standard Tetris colors: I=cyan, O=yellow, T=purple, S=green, Z=red, J=blue, L=orange
-    static const std::array<uint8_t, 7> colors = {6, 3, 5, 2, 1, 4, 11}; // Using console colors
-    return colors[static_cast<size_t>(type_)];
+    return PIECE_COLORS[static_cast<size_t>(type_)];
 }
 
 void Tetromino::reset() noexcept {
@@ -96,64 +81,13 @@ void Tetromino::reset() noexcept {
     rotation_ = Rotation::NORTH;
 }
 
-const Tetromino::ShapeArray& Tetromino::getShapeArray(TetrominoType type) noexcept {
-    return PIECE_SHAPES[static_cast<size_t>(type)];
-}
-
-// All piece shapes are defined here for all 4 rotations
-std::array<Tetromino::ShapeArray, 7> Tetromino::initializePieceShapes() {
-    std::array<ShapeArray, 7> shapes{};
-
-    // I piece
-    shapes[0][0] = {{ {{0,0,0,0}}, {{1,1,1,1}}, {{0,0,0,0}}, {{0,0,0,0}} }};
-    shapes[0][1] = {{ {{0,0,1,0}}, {{0,0,1,0}}, {{0,0,1,0}}, {{0,0,1,0}} }};
-    shapes[0][2] = {{ {{0,0,0,0}}, {{0,0,0,0}}, {{1,1,1,1}}, {{0,0,0,0}} }};
-    shapes[0][3] = {{ {{0,1,0,0}}, {{0,1,0,0}}, {{0,1,0,0}}, {{0,1,0,0}} }};
-
-    // O piece (all rotations are the same)
-    shapes[1][0] = {{ {{0,1,1,0}}, {{0,1,1,0}}, {{0,0,0,0}}, {{0,0,0,0}} }};
-    shapes[1][1] = shapes[1][0];
-    shapes[1][2] = shapes[1][0];
-    shapes[1][3] = shapes[1][0];
-
-    // T piece
-    shapes[2][0] = {{ {{0,1,0,0}}, {{1,1,1,0}}, {{0,0,0,0}}, {{0,0,0,0}} }};
-    shapes[2][1] = {{ {{0,1,0,0}}, {{0,1,1,0}}, {{0,1,0,0}}, {{0,0,0,0}} }};
-    shapes[2][2] = {{ {{0,0,0,0}}, {{1,1,1,0}}, {{0,1,0,0}}, {{0,0,0,0}} }};
-    shapes[2][3] = {{ {{0,1,0,0}}, {{1,1,0,0}}, {{0,1,0,0}}, {{0,0,0,0}} }};
-
-    // S piece
-    shapes[3][0] = {{ {{0,1,1,0}}, {{1,1,0,0}}, {{0,0,0,0}}, {{0,0,0,0}} }};
-    shapes[3][1] = {{ {{0,1,0,0}}, {{0,1,1,0}}, {{0,0,1,0}}, {{0,0,0,0}} }};
-    shapes[3][2] = {{ {{0,0,0,0}}, {{0,1,1,0}}, {{1,1,0,0}}, {{0,0,0,0}} }};
-    shapes[3][3] = {{ {{1,0,0,0}}, {{1,1,0,0}}, {{0,1,0,0}}, {{0,0,0,0}} }};
-
-    // Z piece
-    shapes[4][0] = {{ {{1,1,0,0}}, {{0,1,1,0}}, {{0,0,0,0}}, {{0,0,0,0}} }};
-    shapes[4][1] = {{ {{0,0,1,0}}, {{0,1,1,0}}, {{0,1,0,0}}, {{0,0,0,0}} }};
-    shapes[4][2] = {{ {{0,0,0,0}}, {{1,1,0,0}}, {{0,1,1,0}}, {{0,0,0,0}} }};
-    shapes[4][3] = {{ {{0,1,0,0}}, {{1,1,0,0}}, {{1,0,0,0}}, {{0,0,0,0}} }};
-
-    // J piece
-    shapes[5][0] = {{ {{1,0,0,0}}, {{1,1,1,0}}, {{0,0,0,0}}, {{0,0,0,0}} }};
-    shapes[5][1] = {{ {{0,1,1,0}}, {{0,1,0,0}}, {{0,1,0,0}}, {{0,0,0,0}} }};
-    shapes[5][2] = {{ {{0,0,0,0}}, {{1,1,1,0}}, {{0,0,1,0}}, {{0,0,0,0}} }};
-    shapes[5][3] = {{ {{0,1,0,0}}, {{0,1,0,0}}, {{1,1,0,0}}, {{0,0,0,0}} }};
-
-    // L piece
-    shapes[6][0] = {{ {{0,0,1,0}}, {{1,1,1,0}}, {{0,0,0,0}}, {{0,0,0,0}} }};
-    shapes[6][1] = {{ {{0,1,0,0}}, {{0,1,0,0}}, {{0,1,1,0}}, {{0,0,0,0}} }};
-    shapes[6][2] = {{ {{0,0,0,0}}, {{1,1,1,0}}, {{1,0,0,0}}, {{0,0,0,0}} }};
-    shapes[6][3] = {{ {{1,1,0,0}}, {{0,1,0,0}}, {{0,1,0,0}}, {{0,0,0,0}} }};
-
-    return shapes;
+Tetromino createRandomTetromino(const Position& pos) {
+    thread_local Pcg32 rng((static_cast<uint64_t>(std::random_device{}()) << 32) | std::random_device{}());
+    return createRandomTetromino(rng, pos);
 }
 
-Tetromino createRandomTetromino(const Position& pos) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_int_distribution<> distrib(0, 6);
-    return Tetromino(static_cast<TetrominoType>(distrib(gen)), pos);
+Tetromino createRandomTetromino(Pcg32& rng, const Position& pos) {
+    return Tetromino(static_cast<TetrominoType>(rng.bounded(PIECE_TYPE_COUNT)), pos);
 }
 
 Tetromino createTetromino(TetrominoType type, const Position& pos) {
@@ -0,0 +1,80 @@
+#include "ThreadPool.h"
+
+namespace Tetris {
+
+ThreadPool::ThreadPool(int threads) {
+    if (threads <= 0) {
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    workers_.reserve(static_cast<size_t>(threads - 1));
+    for (int worker = 1; worker < threads; ++worker) {
+        workers_.emplace_back([this, worker] { workerLoop(worker); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    start_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int index, int worker)>& body) {
+    if (count <= 0) return;
+    if (workers_.empty() || count == 1) {
+        for (int i = 0; i < count; ++i) body(i, 0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        body_ = &body;
+        count_ = count;
+        next_index_.store(0, std::memory_order_relaxed);
+        busy_workers_ = static_cast<int>(workers_.size());
+        generation_++;
+    }
+    start_.notify_all();
+
+    runIndices(body, count, 0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return busy_workers_ == 0; });
+    body_ = nullptr;
+}
+
+void ThreadPool::workerLoop(int worker) {
+    uint64_t seen_generation = 0;
+    for (;;) {
+        const std::function<void(int, int)>* body;
+        int count;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_.wait(lock, [&] { return stopping_ || generation_ != seen_generation; });
+            if (stopping_) return;
+            seen_generation = generation_;
+            body = body_;
+            count = count_;
+        }
+
+        runIndices(*body, count, worker);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--busy_workers_ == 0) {
+            done_.notify_one();
+        }
+    }
+}
+
+void ThreadPool::runIndices(const std::function<void(int, int)>& body, int count, int worker) {
+    for (int i = next_index_.fetch_add(1, std::memory_order_relaxed); i < count;
+         i = next_index_.fetch_add(1, std::memory_order_relaxed)) {
+        body(i, worker);
+    }
+}
+
+} // namespace Tetris
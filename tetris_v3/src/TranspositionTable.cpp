@@ -0,0 +1,44 @@
+#include "TranspositionTable.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace Tetris {
+
+TranspositionTable::TranspositionTable(size_t megabytes) {
+    if (megabytes == 0) {
+        throw std::invalid_argument("transposition table size must be at least 1 MB");
+    }
+
+    // Largest power of two bucket count that fits; 1 MB already gives far more than the 256 buckets needed
+    const size_t fit = megabytes * 1024 * 1024 / sizeof(Bucket);
+    size_t buckets = 256;
+    while (buckets * 2 <= fit) {
+        buckets *= 2;
+    }
+    buckets_ = std::make_unique<Bucket[]>(buckets);
+    bucket_mask_ = buckets - 1;
+    clear();
+}
+
+void TranspositionTable::clear() noexcept {
+    for (size_t i = 0; i <= bucket_mask_; ++i) {
+        for (Slot& slot : buckets_[i].slots) {
+            slot.check.store(0, std::memory_order_relaxed);
+            slot.data.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+double TranspositionTable::occupancy() const noexcept {
+    const size_t sample = std::min<size_t>(bucket_mask_ + 1, 4096);
+    size_t used = 0;
+    for (size_t i = 0; i < sample; ++i) {
+        for (const Slot& slot : buckets_[i].slots) {
+            const uint64_t tagged = slot.check.load(std::memory_order_relaxed) ^ slot.data.load(std::memory_order_relaxed);
+            used += (tagged & DEPTH_MASK) != 0;
+        }
+    }
+    return static_cast<double>(used) / static_cast<double>(sample * BUCKET_SLOTS);
+}
+
+} // namespace Tetris
@@ -0,0 +1,307 @@
+#include "WeightTuner.h"
+#include "Random.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+namespace Tetris {
+
+namespace {
+
+constexpr int CHECKPOINT_VERSION = 3;
+
+const WeightTuner::Config& checkConfig(const WeightTuner::Config& config) {
+    if (config.population < 2 || config.games < 1 || config.max_pieces < 1) {
+        throw std::invalid_argument("tuner needs a population of 2+, 1+ games and 1+ pieces per game");
+    }
+    if (!(config.elite_fraction > 0.0 && config.elite_fraction <= 1.0)) {
+        throw std::invalid_argument("tuner elite fraction must be in (0, 1]");
+    }
+    return config;
+}
+
+// Standard normal draw (Box-Muller)
+double gaussian(Pcg32& rng) {
+    const double u1 = (static_cast<double>(rng.next()) + 0.5) / 4294967296.0;
+    const double u2 = (static_cast<double>(rng.next()) + 0.5) / 4294967296.0;
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+}
+
+} // namespace
+
+WeightTuner::WeightTuner(const Config& config)
+    : config_(checkConfig(config))
+    , pool_(config.threads)
+{
+    generators_.resize(static_cast<size_t>(pool_.size()));
+    for (auto& generator : generators_) {
+        generator = std::make_unique<MoveGenerator>();
+    }
+    candidates_.resize(static_cast<size_t>(config_.population));
+    lines_.resize(static_cast<size_t>(config_.population) * static_cast<size_t>(config_.games));
+    start(Evaluator::defaultWeights(), 1);
+}
+
+WeightTuner::~WeightTuner() = default;
+
+void WeightTuner::start(const Evaluator::Weights& initial, uint64_t seed) {
+    state_ = State{};
+    state_.seed = seed;
+    state_.mean = initial;
+    state_.stddev.fill(config_.initial_stddev);
+    state_.population = config_.population;
+    state_.games = config_.games;
+    state_.max_pieces = config_.max_pieces;
+    state_.elite_fraction = config_.elite_fraction;
+    state_.initial_stddev = config_.initial_stddev;
+    state_.extra_noise = config_.extra_noise;
+    state_.noise_generations = config_.noise_generations;
+}
+
+void WeightTuner::resume(const State& state) {
+    // Every setting but the thread count shapes the trajectory; checkpoints store doubles exactly
+    if (state.population != config_.population || state.games != config_.games ||
+        state.max_pieces != config_.max_pieces || state.elite_fraction != config_.elite_fraction ||
+        state.initial_stddev != config_.initial_stddev || state.extra_noise != config_.extra_noise ||
+        state.noise_generations != config_.noise_generations) {
+        std::ostringstream settings;
+        settings << std::setprecision(std::numeric_limits<double>::max_digits10)
+                 << "population " << state.population << ", " << state.games << " games, max_pieces "
+                 << state.max_pieces << ", elite_fraction " << state.elite_fraction << ", initial_stddev "
+                 << state.initial_stddev << ", extra_noise " << state.extra_noise << ", noise_generations "
+                 << state.noise_generations;
+        throw std::invalid_argument("checkpoint was made with " + settings.str() + "; resume with the same settings");
+    }
+    state_ = state;
+}
+
+WeightTuner::Generation WeightTuner::runGeneration() {
+    const auto start_time = std::chrono::steady_clock::now();
+    Generation report;
+    report.generation = state_.generation;
+
+    // Game seeds first, then the population, all from this generation's own stream
+    Pcg32 rng(state_.seed, static_cast<uint64_t>(state_.generation));
+    std::vector<uint64_t> seeds(static_cast<size_t>(config_.games));
+    for (auto& seed : seeds) {
+        seed = static_cast<uint64_t>(rng.next()) << 32 | rng.next();
+    }
+    for (auto& candidate : candidates_) {
+        for (int i = 0; i < FEATURE_COUNT; ++i) {
+            candidate[i] = state_.mean[i] + state_.stddev[i] * gaussian(rng);
+        }
+    }
+
+    pool_.parallelFor(static_cast<int>(lines_.size()), [this, &seeds](int task, int worker) {
+        const int candidate = task / config_.games;
+        const int game = task % config_.games;
+        const Evaluator evaluator(candidates_[candidate]);
+        lines_[task] = playGame(evaluator, seeds[game], config_.max_pieces, *generators_[worker]);
+    });
+
+    // Fitness: mean lines per candidate; ties go to the earlier candidate
+    std::vector<double> fitness(candidates_.size());
+    std::vector<int> order(candidates_.size());
+    for (size_t c = 0; c < candidates_.size(); ++c) {
+        const auto first = lines_.begin() + static_cast<std::ptrdiff_t>(c * config_.games);
+        fitness[c] = std::accumulate(first, first + config_.games, 0.0) / config_.games;
+        order[c] = static_cast<int>(c);
+    }
+    std::stable_sort(order.begin(), order.end(), [&fitness](int a, int b) { return fitness[a] > fitness[b]; });
+
+    const int elite = std::max(1, static_cast<int>(std::ceil(config_.elite_fraction * config_.population)));
+    const double noise = config_.noise_generations > 0
+        ? config_.extra_noise * std::max(0.0, 1.0 - static_cast<double>(state_.generation) / config_.noise_generations)
+        : 0.0;
+    for (int i = 0; i < FEATURE_COUNT; ++i) {
+        double sum = 0.0;
+        for (int e = 0; e < elite; ++e) sum += candidates_[order[e]][i];
+        const double mean = sum / elite;
+        double variance = 0.0;
+        for (int e = 0; e < elite; ++e) {
+            const double d = candidates_[order[e]][i] - mean;
+            variance += d * d;
+        }
+        state_.mean[i] = mean;
+        state_.stddev[i] = std::sqrt(variance / elite + noise);
+    }
+
+    report.lines = lines_;
+    std::sort(report.lines.begin(), report.lines.end());
+    report.mean_fitness = std::accumulate(fitness.begin(), fitness.end(), 0.0) / static_cast<double>(fitness.size());
+    double elite_sum = 0.0;
+    for (int e = 0; e < elite; ++e) elite_sum += fitness[order[e]];
+    report.elite_fitness = elite_sum / elite;
+    report.best_fitness = fitness[order[0]];
+    report.best_weights = candidates_[order[0]];
+    if (report.best_fitness > state_.best_fitness) {
+        state_.best_fitness = report.best_fitness;
+        state_.best = report.best_weights;
+    }
+
+    state_.generation++;
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    return report;
+}
+
+int WeightTuner::playGame(const Evaluator& evaluator, uint64_t seed, int max_pieces, MoveGenerator& generator) {
+    Board board;
+    Pcg32 rng(seed);
+    std::array<TetrominoType, PIECE_TYPE_COUNT> bag{};
+    size_t bag_index = bag.size();
+    int lines = 0;
+    Board::UndoRecord record;
+    for (int piece = 0; piece < max_pieces; ++piece) {
+        if (bag_index == bag.size()) {
+            for (size_t i = 0; i < bag.size(); ++i) bag[i] = static_cast<TetrominoType>(i);
+            rng.shuffle(bag);
+            bag_index = 0;
+        }
+        if (generator.generate(board, createTetromino(bag[bag_index++], {Board::SPAWN_X, Board::SPAWN_Y})) == 0) break;
+
+        board.applyPiece(generator.piece(generator[bestPlacement(board, generator, evaluator)]), record);
+        lines += record.lines_cleared;
+        if (board.isGameOver()) break;
+    }
+    return lines;
+}
+
+void WeightTuner::writeCheckpoint(std::ostream& out, const State& state) {
+    out << "# tetris_v3 tuner checkpoint\n"
+        << std::setprecision(std::numeric_limits<double>::max_digits10)
+        << "version " << CHECKPOINT_VERSION << '\n'
+        << "seed " << state.seed << '\n'
+        << "generation " << state.generation << '\n'
+        << "best_fitness " << state.best_fitness << '\n'
+        << "population " << state.population << '\n'
+        << "games " << state.games << '\n'
+        << "max_pieces " << state.max_pieces << '\n'
+        << "elite_fraction " << state.elite_fraction << '\n'
+        << "initial_stddev " << state.initial_stddev << '\n'
+        << "extra_noise " << state.extra_noise << '\n'
+        << "noise_generations " << state.noise_generations << '\n';
+    const std::pair<const char*, const Evaluator::Weights*> vectors[] = {
+        {"mean", &state.mean}, {"stddev", &state.stddev}, {"best", &state.best}};
+    for (const auto& [label, weights] : vectors) {
+        for (int i = 0; i < FEATURE_COUNT; ++i) {
+            out << label << ' ' << FEATURE_NAMES[i] << ' ' << (*weights)[i] << '\n';
+        }
+    }
+}
+
+WeightTuner::State WeightTuner::parseCheckpoint(std::istream& in, const std::string& source) {
+    State state;
+    // Scalars: version, seed, generation, best_fitness, population, games, max_pieces, elite_fraction,
+    // initial_stddev, extra_noise, noise_generations; then one flag per vector entry
+    std::array<bool, 11> scalars{};
+    std::array<std::array<bool, FEATURE_COUNT>, 3> entries{};
+    std::string line;
+    for (int line_number = 1; std::getline(in, line); ++line_number) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string key;
+        if (!(fields >> key)) continue;
+
+        const std::string where = source + ":" + std::to_string(line_number) + ": ";
+        bool parsed = false;
+        if (key == "version") {
+            int version = 0;
+            parsed = static_cast<bool>(fields >> version);
+            if (parsed && version != CHECKPOINT_VERSION) {
+                throw std::runtime_error(where + "unsupported checkpoint version " + std::to_string(version));
+            }
+            scalars[0] = true;
+        } else if (key == "seed") {
+            parsed = static_cast<bool>(fields >> state.seed);
+            scalars[1] = true;
+        } else if (key == "generation") {
+            parsed = static_cast<bool>(fields >> state.generation) && state.generation >= 0;
+            scalars[2] = true;
+        } else if (key == "best_fitness") {
+            parsed = static_cast<bool>(fields >> state.best_fitness);
+            scalars[3] = true;
+        } else if (key == "population") {
+            parsed = static_cast<bool>(fields >> state.population) && state.population >= 2;
+            scalars[4] = true;
+        } else if (key == "games") {
+            parsed = static_cast<bool>(fields >> state.games) && state.games >= 1;
+            scalars[5] = true;
+        } else if (key == "max_pieces") {
+            parsed = static_cast<bool>(fields >> state.max_pieces) && state.max_pieces >= 1;
+            scalars[6] = true;
+        } else if (key == "elite_fraction") {
+            parsed = static_cast<bool>(fields >> state.elite_fraction) && state.elite_fraction > 0.0 &&
+                state.elite_fraction <= 1.0;
+            scalars[7] = true;
+        } else if (key == "initial_stddev") {
+            parsed = static_cast<bool>(fields >> state.initial_stddev);
+            scalars[8] = true;
+        } else if (key == "extra_noise") {
+            parsed = static_cast<bool>(fields >> state.extra_noise);
+            scalars[9] = true;
+        } else if (key == "noise_generations") {
+            parsed = static_cast<bool>(fields >> state.noise_generations);
+            scalars[10] = true;
+        } else if (key == "mean" || key == "stddev" || key == "best") {
+            const int vector = key == "mean" ? 0 : (key == "stddev" ? 1 : 2);
+            Evaluator::Weights& weights = vector == 0 ? state.mean : (vector == 1 ? state.stddev : state.best);
+            std::string name;
+            fields >> name;
+            const auto found = std::find(FEATURE_NAMES.begin(), FEATURE_NAMES.end(), name);
+            if (found == FEATURE_NAMES.end()) {
+                throw std::runtime_error(where + "unknown feature '" + name + "'");
+            }
+            const auto index = static_cast<size_t>(found - FEATURE_NAMES.begin());
+            parsed = static_cast<bool>(fields >> weights[index]);
+            entries[vector][index] = true;
+        } else {
+            throw std::runtime_error(where + "unknown key '" + key + "'");
+        }
+        std::string rest;
+        if (!parsed || fields >> rest) {
+            throw std::runtime_error(where + "malformed '" + key + "' line");
+        }
+    }
+
+    const bool complete = std::all_of(scalars.begin(), scalars.end(), [](bool seen) { return seen; }) &&
+        std::all_of(entries.begin(), entries.end(), [](const auto& seen) {
+            return std::all_of(seen.begin(), seen.end(), [](bool s) { return s; });
+        });
+    if (!complete) {
+        throw std::runtime_error(source + ": incomplete checkpoint");
+    }
+    return state;
+}
+
+void WeightTuner::saveCheckpoint(const std::string& path, const State& state) {
+    // Write a temporary file and rename it over the old checkpoint, so a crash never leaves half a file
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        writeCheckpoint(file, state);
+        file.flush();
+        if (!file) throw std::runtime_error("Cannot write checkpoint: " + temporary);
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        // Some platforms refuse to rename over an existing file
+        std::remove(path.c_str());
+        if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+            throw std::runtime_error("Cannot replace checkpoint: " + path);
+        }
+    }
+}
+
+WeightTuner::State WeightTuner::loadCheckpoint(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) throw std::runtime_error("Cannot open checkpoint: " + path);
+    return parseCheckpoint(file, path);
+}
+
+} // namespace Tetris
@@ -1,11 +1,71 @@
 #include "Game.h"
 #include <iostream>
 #include <exception>
+#include <string>
 
-int main() {
+namespace {
+
+// Re-simulate a recording headless at full speed and check it against its stored result
+int verifyReplay(const Tetris::Replay& replay) {
+    Tetris::GameSimulation sim;
+    Tetris::ReplayPlayer player(replay, sim);
+    player.runToEnd();
+    
+    const auto& recorded = replay.getResult();
+    std::cout << "score " << sim.getScore() << " (recorded " << recorded.score << "), "
+              << "lines " << sim.getLinesCleared() << " (" << recorded.lines_cleared << "), "
+              << "pieces " << sim.getCounters().total_pieces << " (" << recorded.total_pieces << "), "
+              << "ticks " << sim.getCounters().ticks << " (" << recorded.ticks << ")" << std::endl;
+    if (!player.matchesRecording()) {
+        std::cout << "replay diverged from the recording" << std::endl;
+        return 2;
+    }
+    std::cout << "replay matches the recording" << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
     try {
+        Tetris::TetrisGame::Config config;
+        std::string replay_path;
+        bool fast = false;
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--seed" && i + 1 < argc) {
+                config.seed = std::stoull(argv[++i]);
+            } else if (arg == "--record" && i + 1 < argc) {
+                config.record_path = argv[++i];
+            } else if (arg == "--replay" && i + 1 < argc) {
+                replay_path = argv[++i];
+            } else if (arg == "--fast") {
+                fast = true;
+            } else if (arg == "--autoplay") {
+                config.autoplay = true;
+            } else if (arg == "--mcts") {
+                config.autoplay = true;
+                config.autoplay_config.search = Tetris::AutoPlayer::Search::MCTS;
+            } else if (arg == "--weights" && i + 1 < argc) {
+                config.autoplay_config.weights = Tetris::Evaluator::loadWeights(argv[++i]);
+            } else {
+                std::cerr << "Usage: " << argv[0] << " [--seed N] [--record FILE] [--replay FILE [--fast]]"
+                          << " [--autoplay [--mcts] [--weights FILE]]" << std::endl;
+                return 1;
+            }
+        }
+        
+        if (!replay_path.empty()) {
+            const auto replay = Tetris::Replay::load(replay_path);
+            if (fast) {
+                return verifyReplay(replay);
+            }
+            auto viewer = Tetris::createCustomGame(config);
+            return viewer ? viewer->playReplay(replay) : 1;
+        }
+        
         // Create and run the Tetris game
-        auto game = Tetris::createStandardGame();
+        auto game = Tetris::createCustomGame(config);
         
         if (!game) {
             std::cerr << "Failed to create Tetris game instance" << std::endl;
@@ -22,4 +82,4 @@ int main() {
         std::cerr << "Unknown error occurred" << std::endl;
         return 1;
     }
-}
\ No newline at end of file
+}
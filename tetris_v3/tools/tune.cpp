@@ -0,0 +1,90 @@
+#include "WeightTuner.h"
+#include <cstdio>
+#include <exception>
+#include <iostream>
+#include <string>
+
+namespace {
+
+// Lines cleared by the game at quantile q of a sorted list
+int quantile(const std::vector<int>& sorted, double q) {
+    return sorted[static_cast<size_t>(q * static_cast<double>(sorted.size() - 1) + 0.5)];
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        Tetris::WeightTuner::Config config;
+        int generations = 10;
+        uint64_t seed = 1;
+        std::string checkpoint_path = "tune.ckpt";
+        std::string init_path;
+        std::string out_path = "best.weights";
+        bool resume = false;
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--generations" && i + 1 < argc) {
+                generations = std::stoi(argv[++i]);
+            } else if (arg == "--population" && i + 1 < argc) {
+                config.population = std::stoi(argv[++i]);
+            } else if (arg == "--games" && i + 1 < argc) {
+                config.games = std::stoi(argv[++i]);
+            } else if (arg == "--max-pieces" && i + 1 < argc) {
+                config.max_pieces = std::stoi(argv[++i]);
+            } else if (arg == "--threads" && i + 1 < argc) {
+                config.threads = std::stoi(argv[++i]);
+            } else if (arg == "--seed" && i + 1 < argc) {
+                seed = std::stoull(argv[++i]);
+            } else if (arg == "--checkpoint" && i + 1 < argc) {
+                checkpoint_path = argv[++i];
+            } else if (arg == "--resume") {
+                resume = true;
+            } else if (arg == "--init" && i + 1 < argc) {
+                init_path = argv[++i];
+            } else if (arg == "--out" && i + 1 < argc) {
+                out_path = argv[++i];
+            } else {
+                std::cerr << "Usage: " << argv[0] << " [--generations N] [--population N] [--games N]"
+                          << " [--max-pieces N] [--threads N] [--seed N] [--checkpoint FILE]"
+                          << " [--resume | --init FILE] [--out FILE]" << std::endl;
+                return 1;
+            }
+        }
+
+        Tetris::WeightTuner tuner(config);
+        if (resume) {
+            tuner.resume(Tetris::WeightTuner::loadCheckpoint(checkpoint_path));
+        } else {
+            tuner.start(init_path.empty() ? Tetris::Evaluator::defaultWeights() : Tetris::Evaluator::loadWeights(init_path),
+                        seed);
+        }
+        std::printf("population %d, %d games of up to %d pieces, %d threads, starting at generation %d\n",
+                    config.population, config.games, config.max_pieces, tuner.threadCount(),
+                    tuner.getState().generation);
+
+        for (int g = 0; g < generations; ++g) {
+            const auto report = tuner.runGeneration();
+            const auto& lines = report.lines;
+            std::printf("gen %3d  lines min %4d p10 %4d median %4d p90 %4d max %4d | fitness mean %7.1f elite %7.1f "
+                        "best %7.1f | %.1f s\n",
+                        report.generation, lines.front(), quantile(lines, 0.1), quantile(lines, 0.5),
+                        quantile(lines, 0.9), lines.back(), report.mean_fitness, report.elite_fitness,
+                        report.best_fitness, report.seconds);
+            std::fflush(stdout);
+
+            const auto& state = tuner.getState();
+            Tetris::WeightTuner::saveCheckpoint(checkpoint_path, state);
+            Tetris::Evaluator::saveWeights(out_path, state.best);
+        }
+
+        const auto& state = tuner.getState();
+        std::printf("best mean lines %.1f, weights in %s, checkpoint in %s\n", state.best_fitness, out_path.c_str(),
+                    checkpoint_path.c_str());
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
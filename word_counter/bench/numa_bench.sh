@@ -0,0 +1,48 @@
+#!/bin/sh
+# 고정 배치(--affinity=numa)와 비고정 배치(--affinity=none)의 처리량 비교
+#
+# 사용법: bench/numa_bench.sh [입력파일] [반복횟수] [스레드수]
+# 입력 파일을 주지 않으면 임시로 1 GiB 텍스트 파일을 만든다.
+# 두 번째 실행부터 페이지 캐시에 올라간 상태를 재므로 첫 실행 결과는 버린다.
+
+set -e
+
+BIN=${WORD_COUNTER:-./word_counter}
+INPUT=$1
+RUNS=${2:-5}
+THREADS=${3:-$(nproc)}
+CLEANUP=
+
+if [ -z "$INPUT" ]; then
+    INPUT=$(mktemp /tmp/numa_bench.XXXXXX)
+    CLEANUP=$INPUT
+    trap 'rm -f "$CLEANUP"' EXIT
+    yes "the quick brown fox jumps over the lazy dog" | head -c 1073741824 > "$INPUT"
+fi
+
+if [ ! -x "$BIN" ]; then
+    echo "word_counter 실행 파일이 없습니다: $BIN (WORD_COUNTER 환경 변수로 지정)" >&2
+    exit 1
+fi
+
+run() {
+    "$BIN" --stats --threads="$THREADS" --affinity="$1" "$INPUT" 2>&1 >/dev/null |
+        awk '/throughput/ { for (i = 1; i <= NF; i++) if ($i == "MB/s") print $(i - 1) }'
+}
+
+echo "input: $INPUT, threads: $THREADS, runs: $RUNS"
+"$BIN" --stats --threads="$THREADS" "$INPUT" 2>&1 >/dev/null | grep placement || true
+
+for placement in numa none; do
+    run "$placement" > /dev/null
+    i=0
+    results=
+    while [ "$i" -lt "$RUNS" ]; do
+        results="$results $(run "$placement")"
+        i=$((i + 1))
+    done
+    echo "$results" | tr ' ' '\n' | sort -n | awk -v name="$placement" '
+        NF { v[n++] = $1; sum += $1 }
+        END { printf "%-5s median %8.1f MB/s  mean %8.1f MB/s  (min %.1f, max %.1f)\n",
+                     name, v[int(n / 2)], sum / n, v[0], v[n - 1] }'
+done
@@ -0,0 +1,64 @@
+#!/bin/sh
+# 희소 파일 구멍 건너뛰기 검사
+#
+# 사용법: bench/sparse_test.sh
+# 64 MiB 희소 파일(truncate)에 dd conv=notrunc로 데이터 구간 몇 개를 쓴 뒤
+#   1) 구멍을 건너뛰는 기본 경로와 구멍도 읽는 --ngrams 경로가 고정된 기대값과 같은지,
+#   2) 구멍 안에서 나뉜 --range 체크포인트들을 --merge한 결과가 전체와 같은지
+# 확인한다. 단어 하나는 데이터 끝에서 구멍으로 이어지고, 파일은 구멍으로 끝난다.
+
+set -e
+
+BIN=${WORD_COUNTER:-./word_counter}
+MIB=1048576
+
+if [ ! -x "$BIN" ]; then
+    echo "word_counter 실행 파일이 없습니다: $BIN (WORD_COUNTER 환경 변수로 지정)" >&2
+    exit 1
+fi
+
+DIR=$(mktemp -d /tmp/sparse_test.XXXXXX)
+trap 'rm -rf "$DIR"' EXIT
+FILE=$DIR/sparse.bin
+
+truncate -s $((64 * MIB)) "$FILE"
+put() {
+    printf "$2" | dd of="$FILE" bs=1 seek="$1" conv=notrunc status=none
+}
+put 0 'alpha beta\ngamma '
+put $((16 * MIB - 3)) 'del'
+put $((40 * MIB)) '\nepsilon zeta\n\neta'
+put $((48 * MIB + 7)) ' theta\n'
+
+failures=0
+check() {
+    if [ "$2" = "$3" ]; then
+        echo "ok    $1: $2"
+    else
+        echo "FAIL  $1: $2 (expected $3)"
+        failures=$((failures + 1))
+    fi
+}
+
+counts() {
+    "$BIN" "$@" | head -n 1 | awk '{ print $1, $2, $3 }'
+}
+
+# 개행 5개 + 끝의 NUL 줄, 단어 9개(NUL 구간은 단어 경계가 아니다), 글자 64 MiB
+expected="6 9 $((64 * MIB))"
+check "holes read (--ngrams path)" "$(counts --ngrams=1 "$FILE")" "$expected"
+check "holes skipped" "$(counts "$FILE")" "$expected"
+check "one thread" "$(counts --threads=1 "$FILE")" "$expected"
+skipped=$("$BIN" --stats "$FILE" 2>&1 >/dev/null | sed -n 's/.* \([0-9]*\) in holes).*/\1/p')
+echo "info  ${skipped:-0} bytes skipped as holes (0 if the file system lacks SEEK_HOLE)"
+
+# 구간 경계가 모두 구멍 안에 있고, 가운데 구간은 구멍뿐이다
+"$BIN" --range=0:$((20 * MIB)) --checkpoint="$DIR/part0" "$FILE" > /dev/null
+"$BIN" --range=$((20 * MIB)):$((30 * MIB)) --checkpoint="$DIR/part1" "$FILE" > /dev/null
+"$BIN" --range=$((30 * MIB)): --checkpoint="$DIR/part2" "$FILE" > /dev/null
+check "ranges split in holes, merged" "$(counts --merge "$DIR/part2" "$DIR/part0" "$DIR/part1")" "$expected"
+
+if [ "$failures" -ne 0 ]; then
+    echo "$failures check(s) failed"
+    exit 1
+fi
@@ -0,0 +1,67 @@
+#include "checkpoint.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+const char* const MAGIC = "word_counter-checkpoint";
+const int VERSION = 1;
+
+} // namespace
+
+const uint64_t Checkpoint::TO_END;
+
+bool write_checkpoint(const std::string& path, const Checkpoint& checkpoint) {
+    const std::string temp_path = path + ".tmp";
+    {
+        std::ofstream out(temp_path, std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Error: Cannot write checkpoint '" << temp_path << "'" << std::endl;
+            return false;
+        }
+        out << MAGIC << ' ' << VERSION << '\n'
+            << "size " << checkpoint.file_size << '\n'
+            << "begin " << checkpoint.begin << '\n'
+            << "end " << checkpoint.end << '\n'
+            << "offset " << checkpoint.offset << '\n'
+            << "counter ";
+        checkpoint.counter.write_state(out);
+        // 파일 경로는 공백을 포함할 수 있으므로 마지막 줄 전체로 저장
+        out << '\n' << "file " << checkpoint.file << '\n';
+        out.flush();
+        if (!out) {
+            std::cerr << "Error: Failed to write checkpoint '" << temp_path << "'" << std::endl;
+            return false;
+        }
+    }
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        std::cerr << "Error: Cannot replace checkpoint '" << path << "'" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool read_checkpoint(const std::string& path, Checkpoint& checkpoint) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        std::cerr << "Error: Cannot open checkpoint '" << path << "'" << std::endl;
+        return false;
+    }
+
+    std::string magic, key;
+    int version = 0;
+    bool ok = static_cast<bool>(in >> magic >> version) && magic == MAGIC && version == VERSION;
+    ok = ok && (in >> key >> checkpoint.file_size) && key == "size";
+    ok = ok && (in >> key >> checkpoint.begin) && key == "begin";
+    ok = ok && (in >> key >> checkpoint.end) && key == "end";
+    ok = ok && (in >> key >> checkpoint.offset) && key == "offset";
+    ok = ok && (in >> key) && key == "counter" && checkpoint.counter.read_state(in);
+    ok = ok && (in >> key) && key == "file" && in.get() == ' ' && std::getline(in, checkpoint.file);
+    if (!ok || checkpoint.offset < checkpoint.begin) {
+        std::cerr << "Error: Invalid checkpoint '" << path << "'" << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "counter.h"
+
+#include <cstdint>
+#include <string>
+
+// 한 파일의 한 바이트 구간 [begin, end)을 세는 중간 상태
+//
+// offset까지 센 WordCounter 상태(경계 플래그 포함)를 담는다. 같은 실행을
+// offset에서 재개하거나, 여러 머신이 나눠 센 인접 구간을 순서대로 병합하는 데 쓴다.
+struct Checkpoint {
+    static const uint64_t TO_END = UINT64_MAX;  // end: 파일 끝까지
+
+    std::string file;        // 원본 파일 경로
+    uint64_t file_size = 0;  // 셀 때의 파일 크기 (파일이 바뀌었는지 확인용)
+    uint64_t begin = 0;      // 구간 시작 오프셋
+    uint64_t end = TO_END;   // 구간 끝 오프셋 (포함하지 않음)
+    uint64_t offset = 0;     // 여기까지 셌음 (재개 위치)
+    WordCounter counter;
+
+    bool is_complete() const { return offset >= end || offset >= file_size; }
+};
+
+// 임시 파일에 쓴 뒤 rename하므로 도중에 죽어도 이전 체크포인트가 남는다
+bool write_checkpoint(const std::string& path, const Checkpoint& checkpoint);
+bool read_checkpoint(const std::string& path, Checkpoint& checkpoint);
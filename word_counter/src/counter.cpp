@@ -0,0 +1,323 @@
+#include "counter.h"
+
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <utility>
+
+namespace {
+
+// 토큰 해시: 바이트 단위 다항 해시 (조각을 이어 붙일 때 산술적으로 합칠 수 있다)
+const uint64_t BYTE_BASE = 0x100000001b3ULL;
+// n-gram 롤링 해시: 토큰 해시의 다항식
+const uint64_t TOKEN_BASE = 0x9E3779B97F4A7C15ULL;
+
+uint64_t power(uint64_t base, uint64_t exp) {
+    uint64_t result = 1;
+    while (exp > 0) {
+        if (exp & 1) result *= base;
+        base *= base;
+        exp >>= 1;
+    }
+    return result;
+}
+
+uint64_t mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// WordCounter
+
+void WordCounter::write_state(std::ostream& out) const {
+    out << lines << ' ' << words << ' ' << chars << ' '
+        << starts_in_word << ' ' << in_word << ' ' << prev_was_newline;
+}
+
+bool WordCounter::read_state(std::istream& in) {
+    return static_cast<bool>(in >> lines >> words >> chars
+                                >> starts_in_word >> in_word >> prev_was_newline);
+}
+
+// ---------------------------------------------------------------------------
+// NgramTable
+
+NgramTable::NgramTable() : slots_(16) {}
+
+NgramTable::Entry& NgramTable::find_slot(uint64_t hash) {
+    const size_t mask = slots_.size() - 1;
+    size_t index = static_cast<size_t>(mix(hash)) & mask;
+    while (slots_[index].count != 0 && slots_[index].hash != hash) {
+        index = (index + 1) & mask;
+    }
+    return slots_[index];
+}
+
+void NgramTable::grow() {
+    std::vector<Entry> old(slots_.size() * 2);
+    old.swap(slots_);
+    for (size_t i = 0; i < old.size(); i++) {
+        if (old[i].count == 0) continue;
+        Entry& slot = find_slot(old[i].hash);
+        slot = std::move(old[i]);
+    }
+}
+
+void NgramTable::merge(const NgramTable& other) {
+    for (size_t i = 0; i < other.slots_.size(); i++) {
+        const Entry& entry = other.slots_[i];
+        if (entry.count == 0) continue;
+        add(entry.hash, entry.count, [&entry]() { return entry.text; });
+    }
+}
+
+void NgramTable::swap(NgramTable& other) {
+    slots_.swap(other.slots_);
+    std::swap(size_, other.size_);
+    std::swap(total_, other.total_);
+}
+
+std::vector<const NgramTable::Entry*> NgramTable::top(size_t k) const {
+    std::vector<const Entry*> entries;
+    entries.reserve(size_);
+    for (size_t i = 0; i < slots_.size(); i++) {
+        if (slots_[i].count != 0) entries.push_back(&slots_[i]);
+    }
+    k = std::min(k, entries.size());
+    std::partial_sort(entries.begin(), entries.begin() + k, entries.end(),
+                      [](const Entry* a, const Entry* b) {
+                          if (a->count != b->count) return a->count > b->count;
+                          return a->text < b->text;
+                      });
+    entries.resize(k);
+    return entries;
+}
+
+// ---------------------------------------------------------------------------
+// TokenStats
+
+const size_t TokenStats::MAX_NGRAM;
+const size_t TokenStats::LENGTH_BUCKETS;
+const size_t TokenStats::MAX_TOKEN_TEXT;
+
+TokenStats::TokenStats(size_t ngram)
+    : n_(std::max<size_t>(1, std::min(ngram, MAX_NGRAM))),
+      drop_factor_(power(TOKEN_BASE, n_ - 1)),
+      length_histogram_(LENGTH_BUCKETS, 0) {}
+
+TokenPiece TokenStats::make_piece(const char* begin, size_t length) {
+    TokenPiece piece;
+    for (size_t i = 0; i < length; i++) {
+        piece.hash = piece.hash * BYTE_BASE + static_cast<unsigned char>(begin[i]) + 1;
+    }
+    piece.length = length;
+    piece.text.assign(begin, std::min(length, MAX_TOKEN_TEXT));
+    return piece;
+}
+
+TokenPiece TokenStats::join(const TokenPiece& left, const TokenPiece& right) {
+    TokenPiece piece;
+    piece.hash = left.hash * power(BYTE_BASE, right.length) + right.hash;
+    piece.length = left.length + right.length;
+    piece.text = left.text;
+    if (left.length < MAX_TOKEN_TEXT) {
+        piece.text.append(right.text, 0, MAX_TOKEN_TEXT - piece.text.size());
+    }
+    return piece;
+}
+
+void TokenStats::count_length(uint64_t length) {
+    size_t bucket = length >= LENGTH_BUCKETS ? LENGTH_BUCKETS - 1 : static_cast<size_t>(length) - 1;
+    length_histogram_[bucket]++;
+}
+
+void TokenStats::scan(WordCounter& counter, const char* data, size_t size) {
+    chunk_begin_ = data;
+    chunk_end_ = data + size;
+    if (size > 0) {
+        empty_ = false;
+    }
+
+    counter.process(data, size, *this);
+
+    // 마지막 n-1개 내부 토큰은 청크 버퍼가 사라지기 전에 복사해 둔다
+    size_t keep = std::min(recent_count_, n_ - 1);
+    for (size_t i = recent_count_ - keep; i < recent_count_; i++) {
+        TokenPiece piece;
+        piece.hash = recent_[i].hash;
+        piece.length = recent_[i].length;
+        piece.text.assign(recent_[i].text, std::min(recent_[i].length, MAX_TOKEN_TEXT));
+        tail_.push_back(std::move(piece));
+    }
+    chunk_begin_ = chunk_end_ = nullptr;
+}
+
+void TokenStats::on_token(const char* begin, size_t length) {
+    const bool at_begin = begin == chunk_begin_;
+    const bool at_end = begin + length == chunk_end_;
+    if (at_begin || at_end) {
+        // 청크 밖으로 이어질 수 있는 조각은 병합 때 확정한다
+        if (at_begin && at_end) {
+            all_fragment_ = true;
+        }
+        if (at_begin) {
+            has_leading_ = true;
+            leading_ = make_piece(begin, length);
+        }
+        if (at_end) {
+            has_trailing_ = true;
+            trailing_ = at_begin ? leading_ : make_piece(begin, length);
+        }
+        return;
+    }
+
+    uint64_t hash = 0;
+    for (size_t i = 0; i < length; i++) {
+        hash = hash * BYTE_BASE + static_cast<unsigned char>(begin[i]) + 1;
+    }
+    count_length(length);
+    tokens_++;
+
+    if (head_.size() + 1 < n_) {
+        TokenPiece piece;
+        piece.hash = hash;
+        piece.length = length;
+        piece.text.assign(begin, std::min(length, MAX_TOKEN_TEXT));
+        head_.push_back(std::move(piece));
+    }
+
+    // 롤링 해시: 가장 오래된 토큰을 빼고 새 토큰을 더한다
+    if (recent_count_ == n_) {
+        window_hash_ -= recent_[0].hash * drop_factor_;
+        std::copy(recent_ + 1, recent_ + n_, recent_);
+        recent_count_--;
+    }
+    window_hash_ = window_hash_ * TOKEN_BASE + hash;
+    recent_[recent_count_].hash = hash;
+    recent_[recent_count_].text = begin;
+    recent_[recent_count_].length = length;
+    recent_count_++;
+
+    if (recent_count_ == n_) {
+        ngrams_.add(window_hash_, 1, [this]() {
+            std::string text;
+            for (size_t i = 0; i < n_; i++) {
+                if (i > 0) text += ' ';
+                text.append(recent_[i].text, std::min(recent_[i].length, MAX_TOKEN_TEXT));
+            }
+            return text;
+        });
+    }
+}
+
+void TokenStats::add_window(const std::vector<const TokenPiece*>& window) {
+    if (window.size() < n_) return;
+    for (size_t start = 0; start + n_ <= window.size(); start++) {
+        uint64_t hash = 0;
+        for (size_t i = 0; i < n_; i++) {
+            hash = hash * TOKEN_BASE + window[start + i]->hash;
+        }
+        ngrams_.add(hash, 1, [&]() {
+            std::string text;
+            for (size_t i = 0; i < n_; i++) {
+                if (i > 0) text += ' ';
+                text += window[start + i]->text;
+            }
+            return text;
+        });
+    }
+}
+
+void TokenStats::merge(TokenStats next) {
+    if (next.empty_) return;
+    if (empty_) {
+        *this = std::move(next);
+        return;
+    }
+
+    // 공백이 없는 구간은 이웃 조각에 그대로 이어 붙는다
+    if (all_fragment_ && next.all_fragment_) {
+        leading_ = join(leading_, next.leading_);
+        trailing_ = leading_;
+        return;
+    }
+    if (all_fragment_) {
+        TokenPiece leading = next.has_leading_ ? join(leading_, next.leading_) : leading_;
+        *this = std::move(next);
+        leading_ = std::move(leading);
+        has_leading_ = true;
+        return;
+    }
+    if (next.all_fragment_) {
+        trailing_ = has_trailing_ ? join(trailing_, next.leading_) : next.leading_;
+        has_trailing_ = true;
+        return;
+    }
+
+    // 양쪽 모두 공백을 포함하므로 경계의 조각은 하나의 완결된 토큰이 된다
+    std::vector<TokenPiece> sequence(tail_);
+    const bool has_boundary = has_trailing_ || next.has_leading_;
+    if (has_boundary) {
+        TokenPiece boundary;
+        if (has_trailing_ && next.has_leading_) {
+            boundary = join(trailing_, next.leading_);
+        } else {
+            boundary = has_trailing_ ? trailing_ : next.leading_;
+        }
+        count_length(boundary.length);
+        sequence.push_back(std::move(boundary));
+    }
+    sequence.insert(sequence.end(), next.head_.begin(), next.head_.end());
+
+    // 경계를 가로지르는 n-gram: tail과 head는 각각 n-1개 이하이므로
+    // sequence 안의 모든 n 토큰 창은 경계를 포함한다
+    std::vector<const TokenPiece*> window;
+    window.reserve(sequence.size());
+    for (size_t i = 0; i < sequence.size(); i++) {
+        window.push_back(&sequence[i]);
+    }
+    add_window(window);
+
+    if (head_.size() + 1 < n_) {
+        // 왼쪽의 내부 토큰이 n-1개 미만이면 sequence가 왼쪽 전체로 시작한다
+        head_.assign(sequence.begin(), sequence.begin() + std::min(n_ - 1, sequence.size()));
+    }
+    if (next.tokens_ + 1 >= n_) {
+        tail_ = std::move(next.tail_);
+    } else {
+        size_t keep = std::min(n_ - 1, sequence.size());
+        tail_.assign(sequence.end() - keep, sequence.end());
+    }
+
+    tokens_ += next.tokens_ + (has_boundary ? 1 : 0);
+    for (size_t i = 0; i < LENGTH_BUCKETS; i++) {
+        length_histogram_[i] += next.length_histogram_[i];
+    }
+    if (ngrams_.size() < next.ngrams_.size()) {
+        ngrams_.swap(next.ngrams_);
+    }
+    ngrams_.merge(next.ngrams_);
+
+    has_trailing_ = next.has_trailing_;
+    trailing_ = std::move(next.trailing_);
+}
+
+void TokenStats::finalize() {
+    if (empty_) return;
+
+    // 입력 앞뒤를 가상의 공백으로 감싸 양 끝 조각을 확정한다
+    TokenStats edge(n_);
+    edge.empty_ = false;
+
+    TokenStats result(edge);
+    result.merge(std::move(*this));
+    result.merge(std::move(edge));
+    *this = std::move(result);
+}
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// wc 호환 토크나이저의 공백 판정 (단어 경계)
+inline bool is_whitespace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+class WordCounter {
+private:
+    size_t lines = 0;
+    size_t words = 0;
+    size_t chars = 0;
+
+    bool in_word = false;
+    bool prev_was_newline = true;  // 파일 시작은 새 줄로 간주
+    bool starts_in_word = false;   // 첫 글자가 단어 문자인지 (청크 병합 시 경계 단어 보정용)
+
+    // 구간의 첫 바이트를 기록한다. 버퍼마다 한 번만 불러 바이트 루프에서 분기를 뺀다.
+    void note_first(const char* data, size_t size) {
+        if (chars == 0 && size > 0) {
+            starts_in_word = !is_whitespace(data[0]);
+        }
+    }
+
+    // 바이트 하나의 줄/단어 상태 갱신 (chars와 첫 바이트는 호출하는 쪽이 맡는다)
+    void step(char c) {
+        // 줄 수 계산
+        if (c == '\n') {
+            lines++;
+            prev_was_newline = true;
+        } else {
+            prev_was_newline = false;
+        }
+
+        // 단어 수 계산
+        bool is_ws = is_whitespace(c);
+
+        if (!is_ws && !in_word) {
+            // 공백이 아닌 문자를 만나고 현재 단어 안에 있지 않으면 새 단어 시작
+            words++;
+            in_word = true;
+        } else if (is_ws && in_word) {
+            // 공백을 만나고 현재 단어 안에 있으면 단어 끝
+            in_word = false;
+        }
+    }
+
+public:
+    void process_char(char c) {
+        note_first(&c, 1);
+        chars++;
+        step(c);
+    }
+
+    void process(const char* data, size_t size) {
+        note_first(data, size);
+        for (size_t i = 0; i < size; i++) {
+            step(data[i]);
+        }
+        chars += size;
+    }
+
+    // NUL 바이트 count개를 읽지 않고 센다 (희소 파일의 구멍).
+    // NUL은 공백이 아니므로 개행도 단어 경계도 없이 하나의 단어로 이어진다.
+    void process_nul_run(uint64_t count) {
+        if (count == 0) return;
+        if (chars == 0) {
+            starts_in_word = true;
+        }
+        chars += count;
+        prev_was_newline = false;
+        if (!in_word) {
+            words++;
+            in_word = true;
+        }
+    }
+
+    // 같은 한 번의 순회에서 토큰 경계를 sink.on_token(begin, length)으로 알린다.
+    // 버퍼 끝에서 끝나지 않은 토큰은 버퍼 끝까지의 조각으로 알린다.
+    template <typename TokenSink>
+    void process(const char* data, size_t size, TokenSink& sink) {
+        note_first(data, size);
+        const char* token_begin = data;
+        for (size_t i = 0; i < size; i++) {
+            bool was_in_word = in_word;
+            step(data[i]);
+            if (in_word && !was_in_word) {
+                token_begin = data + i;
+            } else if (!in_word && was_in_word) {
+                sink.on_token(token_begin, static_cast<size_t>(data + i - token_begin));
+            }
+        }
+        if (in_word && size > 0) {
+            sink.on_token(token_begin, static_cast<size_t>(data + size - token_begin));
+        }
+        chars += size;
+    }
+
+    // 바로 뒤따르는 구간의 카운트를 합친다 (finalize 전에만 호출)
+    void merge(const WordCounter& next) {
+        if (next.chars == 0) return;
+        if (chars == 0) {
+            *this = next;
+            return;
+        }
+        lines += next.lines;
+        words += next.words;
+        if (in_word && next.starts_in_word) {
+            // 경계에 걸친 단어는 양쪽에서 한 번씩 세어졌다
+            words--;
+        }
+        chars += next.chars;
+        in_word = next.in_word;
+        prev_was_newline = next.prev_was_newline;
+    }
+
+    void finalize() {
+        // 파일이 개행으로 끝나지 않는 경우 마지막 줄 처리
+        if (!prev_was_newline && chars > 0) {
+            lines++;
+        }
+    }
+
+    // 체크포인트용 상태 직렬화 (finalize 전 상태)
+    void write_state(std::ostream& out) const;
+    bool read_state(std::istream& in);
+
+    size_t get_lines() const { return lines; }
+    size_t get_words() const { return words; }
+    size_t get_chars() const { return chars; }
+};
+
+// 토큰 하나의 요약: 바이트 다항 해시, 길이, 표시용 텍스트(앞부분만 보관)
+struct TokenPiece {
+    uint64_t hash = 0;
+    uint64_t length = 0;
+    std::string text;
+};
+
+// n-gram 해시 -> 빈도 (선형 탐사 오픈 어드레싱)
+// 64비트 해시가 같으면 같은 n-gram으로 간주한다.
+class NgramTable {
+public:
+    struct Entry {
+        uint64_t hash = 0;
+        uint64_t count = 0;  // 0이면 빈 슬롯
+        std::string text;    // 처음 삽입될 때의 표시용 텍스트
+    };
+
+    NgramTable();
+
+    // make_text()는 새 항목을 만들 때만 호출된다
+    template <typename MakeText>
+    void add(uint64_t hash, uint64_t count, MakeText make_text) {
+        Entry& slot = find_slot(hash);
+        if (slot.count == 0) {
+            slot.hash = hash;
+            slot.text = make_text();
+            size_++;
+        }
+        slot.count += count;
+        total_ += count;
+        if (size_ * 2 > slots_.size()) {
+            grow();
+        }
+    }
+
+    void merge(const NgramTable& other);
+    void swap(NgramTable& other);
+
+    size_t size() const { return size_; }
+    uint64_t total() const { return total_; }
+
+    // 빈도 내림차순 상위 k개 (동률은 텍스트 순)
+    std::vector<const Entry*> top(size_t k) const;
+
+private:
+    std::vector<Entry> slots_;
+    size_t size_ = 0;
+    uint64_t total_ = 0;
+
+    Entry& find_slot(uint64_t hash);
+    void grow();
+};
+
+// 토큰 길이 히스토그램과 단어 n-gram 통계
+//
+// 청크는 임의의 바이트 위치에서 잘릴 수 있으므로, 청크 양 끝에 닿은 토큰은
+// 조각(leading/trailing)으로 보관했다가 병합 시 이어 붙여 확정한다.
+// 청크 내부 n-gram은 스캔 중 롤링 해시로 세고, 경계를 가로지르는 n-gram은
+// 각 청크의 처음/마지막 n-1개 토큰(head/tail)으로 병합 시 센다.
+class TokenStats {
+public:
+    static const size_t MAX_NGRAM = 5;
+    static const size_t LENGTH_BUCKETS = 32;   // 길이 1..31, 마지막 버킷은 32 이상
+    static const size_t MAX_TOKEN_TEXT = 64;   // 표시용으로 보관하는 토큰 앞부분 길이
+
+    explicit TokenStats(size_t ngram = 1);
+
+    // 한 청크를 WordCounter와 같은 순회로 처리한다 (새로 만든 객체에서만 호출)
+    void scan(WordCounter& counter, const char* data, size_t size);
+
+    // 바로 뒤따르는 청크의 통계를 합친다
+    void merge(TokenStats next);
+
+    // 입력 양 끝의 조각을 완결된 토큰으로 확정한다 (모든 병합이 끝난 뒤 한 번)
+    void finalize();
+
+    size_t ngram_order() const { return n_; }
+    uint64_t token_count() const { return tokens_; }
+    const std::vector<uint64_t>& length_histogram() const { return length_histogram_; }
+    const NgramTable& ngrams() const { return ngrams_; }
+
+    // WordCounter::process의 토큰 콜백
+    void on_token(const char* begin, size_t length);
+
+private:
+    // 청크 내부 스캔용: 최근 n개 토큰 (텍스트는 청크 버퍼를 가리킨다)
+    struct RecentToken {
+        uint64_t hash;
+        const char* text;
+        size_t length;
+    };
+
+    size_t n_;
+    uint64_t drop_factor_;  // TOKEN_BASE^(n-1), 롤링 해시에서 가장 오래된 토큰 제거용
+    NgramTable ngrams_;
+    std::vector<uint64_t> length_histogram_;
+    uint64_t tokens_ = 0;   // 확정된 토큰 수
+
+    bool empty_ = true;          // 아직 아무 바이트도 보지 않음
+    bool all_fragment_ = false;  // 공백이 하나도 없는 구간 (leading == trailing)
+    bool has_leading_ = false;
+    bool has_trailing_ = false;
+    TokenPiece leading_;
+    TokenPiece trailing_;
+    std::vector<TokenPiece> head_;  // 확정된 토큰 중 처음 n-1개
+    std::vector<TokenPiece> tail_;  // 확정된 토큰 중 마지막 n-1개
+
+    const char* chunk_begin_ = nullptr;
+    const char* chunk_end_ = nullptr;
+    RecentToken recent_[MAX_NGRAM];
+    size_t recent_count_ = 0;
+    uint64_t window_hash_ = 0;
+
+    void count_length(uint64_t length);
+    void add_window(const std::vector<const TokenPiece*>& window);
+
+    static TokenPiece make_piece(const char* begin, size_t length);
+    static TokenPiece join(const TokenPiece& left, const TokenPiece& right);
+};
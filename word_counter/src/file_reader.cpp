@@ -0,0 +1,130 @@
+#include "file_reader.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const uint64_t FileReader::UNKNOWN_SIZE;
+
+FileReader::~FileReader() {
+    close();
+}
+
+bool FileReader::open(const std::string& path, bool skip_holes) {
+    close();
+    fd_ = ::open(path.c_str(), O_RDONLY);
+    counters_.opens++;
+    if (fd_ < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd_, &info) != 0) {
+        close();
+        return false;
+    }
+    regular_ = S_ISREG(info.st_mode);
+    size_ = regular_ ? static_cast<uint64_t>(info.st_size) : UNKNOWN_SIZE;
+    skip_holes_ = skip_holes && regular_;
+    data_end_ = 0;
+    return true;
+}
+
+void FileReader::close() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+// offset이 구멍 안이면 구멍 구간을 돌려주고, 데이터 안이면 데이터 구간의 끝을 기록한다
+bool FileReader::find_hole(uint64_t offset, uint64_t limit, Extent& extent) {
+#if defined(SEEK_DATA) && defined(SEEK_HOLE)
+    if (skip_holes_ && offset >= data_end_) {
+        off_t data = lseek(fd_, static_cast<off_t>(offset), SEEK_DATA);
+        counters_.seeks++;
+        if (data < 0 && errno == ENXIO) {
+            // offset 뒤로는 데이터가 없다: 파일 끝까지 구멍
+            data = static_cast<off_t>(size_);
+        } else if (data < 0) {
+            // 파일 시스템이 지원하지 않으면 전부 데이터로 취급
+            skip_holes_ = false;
+            return false;
+        }
+        if (static_cast<uint64_t>(data) > offset) {
+            extent.offset = offset;
+            extent.size = static_cast<size_t>(std::min<uint64_t>(data, limit) - offset);
+            extent.hole = true;
+            counters_.hole_bytes += extent.size;
+            return true;
+        }
+        off_t hole = lseek(fd_, static_cast<off_t>(offset), SEEK_HOLE);
+        counters_.seeks++;
+        data_end_ = hole < 0 ? size_ : static_cast<uint64_t>(hole);
+    }
+#else
+    (void)offset;
+    (void)limit;
+    (void)extent;
+#endif
+    return false;
+}
+
+bool FileReader::next_extent(uint64_t offset, uint64_t limit, size_t max_size, Extent& extent) {
+    extent = Extent();
+    extent.offset = offset;
+    limit = std::min(limit, size_);
+    if (offset >= limit) {
+        return true;
+    }
+
+    if (find_hole(offset, limit, extent)) {
+        return true;
+    }
+
+    uint64_t size = std::min<uint64_t>(max_size, limit - offset);
+    if (skip_holes_) {
+        size = std::min<uint64_t>(size, data_end_ - offset);
+    }
+    extent.size = static_cast<size_t>(size);
+    return true;
+}
+
+bool FileReader::read_extent(const Extent& extent, char* buffer, IoCounters& counters) const {
+    // 요청한 만큼 찰 때까지 읽는다 (짧은 읽기 대응)
+    size_t filled = 0;
+    while (filled < extent.size) {
+        ssize_t result = pread(fd_, buffer + filled, extent.size - filled,
+                               static_cast<off_t>(extent.offset + filled));
+        counters.reads++;
+        if (result < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (result == 0) {
+            // 읽는 도중 파일이 줄어들었다
+            return false;
+        }
+        filled += static_cast<size_t>(result);
+    }
+    counters.bytes_read += filled;
+    return true;
+}
+
+bool FileReader::read_stream(char* buffer, size_t capacity, size_t& filled) {
+    filled = 0;
+    while (filled < capacity) {
+        ssize_t result = read(fd_, buffer + filled, capacity - filled);
+        counters_.reads++;
+        if (result < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (result == 0) break;
+        filled += static_cast<size_t>(result);
+    }
+    counters_.bytes_read += filled;
+    return true;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "run_stats.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 입력 파일을 구간(extent) 단위로 읽는 리더
+//
+// 일반 파일은 다음 구간의 위치만 정해 두고(next_extent) 여러 워커가 각자
+// pread로 읽는다(read_extent). 희소 파일의 구멍(hole)은 SEEK_DATA/SEEK_HOLE로
+// 찾아 읽지 않고 길이만 돌려준다. 구멍은 모두 NUL 바이트다.
+// 파이프 등 일반 파일이 아니면 처음부터 순차적으로 읽는다(read_stream).
+class FileReader {
+public:
+    static const uint64_t UNKNOWN_SIZE = UINT64_MAX;
+
+    struct Extent {
+        uint64_t offset = 0;
+        size_t size = 0;
+        bool hole = false;  // true면 읽을 필요 없음 (NUL size개)
+    };
+
+    FileReader() = default;
+    ~FileReader();
+
+    FileReader(const FileReader&) = delete;
+    FileReader& operator=(const FileReader&) = delete;
+
+    // skip_holes가 false면 구멍도 일반 데이터처럼 읽는다
+    bool open(const std::string& path, bool skip_holes);
+    void close();
+
+    bool is_regular() const { return regular_; }
+    uint64_t size() const { return size_; }
+    const IoCounters& counters() const { return counters_; }
+
+    // 일반 파일: offset부터 limit 전까지 다음 구간을 정한다 (데이터 구간은 max_size 이하).
+    // 파일 끝이면 extent.size == 0
+    bool next_extent(uint64_t offset, uint64_t limit, size_t max_size, Extent& extent);
+
+    // 일반 파일: 데이터 구간을 buffer에 모두 읽는다. 여러 스레드에서 동시에 호출할 수 있다
+    bool read_extent(const Extent& extent, char* buffer, IoCounters& counters) const;
+
+    // 일반 파일이 아닐 때: 최대 capacity 바이트를 순차적으로 읽는다. 끝이면 filled == 0
+    bool read_stream(char* buffer, size_t capacity, size_t& filled);
+
+private:
+    int fd_ = -1;
+    bool regular_ = false;
+    bool skip_holes_ = false;
+    uint64_t size_ = UNKNOWN_SIZE;
+    uint64_t data_end_ = 0;  // [.., data_end_)는 데이터로 확인된 구간
+    IoCounters counters_;
+
+    bool find_hole(uint64_t offset, uint64_t limit, Extent& extent);
+};
@@ -1,97 +1,446 @@
-#include <iostream>
+#include "checkpoint.h"
+#include "counter.h"
+#include "file_reader.h"
+#include "run_stats.h"
+#include "worker_pool.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <iostream>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
-class WordCounter {
-private:
-    size_t lines = 0;
-    size_t words = 0;
-    size_t chars = 0;
-    
-    bool in_word = false;
-    bool prev_was_newline = true;  // 파일 시작은 새 줄로 간주
-    
-public:
-    void process_char(char c) {
-        chars++;
-        
-        // 줄 수 계산
-        if (c == '\n') {
-            lines++;
-            prev_was_newline = true;
-        } else {
-            if (prev_was_newline) {
-                // 새 줄의 첫 번째 문자이면서 개행이 아닌 경우
-                // 이미 줄 카운트는 이전 개행에서 처리됨
-            }
-            prev_was_newline = false;
-        }
-        
-        // 단어 수 계산
-        bool is_whitespace = (c == ' ' || c == '\t' || c == '\n' || c == '\r');
-        
-        if (!is_whitespace && !in_word) {
-            // 공백이 아닌 문자를 만나고 현재 단어 안에 있지 않으면 새 단어 시작
-            words++;
-            in_word = true;
-        } else if (is_whitespace && in_word) {
-            // 공백을 만나고 현재 단어 안에 있으면 단어 끝
-            in_word = false;
-        }
-    }
-    
-    void finalize() {
-        // 파일이 개행으로 끝나지 않는 경우 마지막 줄 처리
-        if (!prev_was_newline && chars > 0) {
-            lines++;
-        }
-    }
-    
-    size_t get_lines() const { return lines; }
-    size_t get_words() const { return words; }
-    size_t get_chars() const { return chars; }
+namespace {
+
+const size_t CHUNK_SIZE = 4 << 20;  // 스레드 하나가 한 번에 세는 바이트 수
+const size_t TOP_NGRAMS = 10;       // 출력할 상위 n-gram 개수
+
+struct Options {
+    size_t ngrams = 0;   // 0이면 토큰 통계를 수집하지 않음
+    unsigned threads = 0;
+    std::string checkpoint_path;
+    uint64_t checkpoint_interval = 1ULL << 30;  // 이만큼 셀 때마다 체크포인트 저장
+    bool resume = false;
+    bool has_range = false;
+    uint64_t range_begin = 0;
+    uint64_t range_end = Checkpoint::TO_END;
+    bool merge = false;  // files를 체크포인트로 보고 병합
+    bool stats = false;  // 실행마다 성능 카운터를 stderr로 출력
+    Placement placement = Placement::NUMA;
+    std::vector<std::string> files;
+};
+
+// 한 라운드에서 워커 하나가 맡는 청크
+struct ChunkTask {
+    FileReader::Extent extent;
+    const char* data = nullptr;  // nullptr이면 워커가 파일에서 직접 읽는다
+};
+
+// 한 청크의 결과: 기본 카운트와 (선택적으로) 토큰 통계
+struct ChunkResult {
+    WordCounter counter;
+    TokenStats stats;
+    IoCounters io;
+    bool failed = false;
+
+    explicit ChunkResult(size_t ngrams) : stats(ngrams) {}
 };
 
-bool count_file(const std::string& filename) {
-    std::ifstream file(filename, std::ios::binary);
-    if (!file.is_open()) {
+void count_chunk(const char* data, size_t size, bool with_stats, ChunkResult& result) {
+    if (with_stats) {
+        result.stats.scan(result.counter, data, size);
+    } else {
+        result.counter.process(data, size);
+    }
+}
+
+void print_token_stats(const TokenStats& stats) {
+    const std::vector<uint64_t>& histogram = stats.length_histogram();
+    std::cout << "  token lengths (" << stats.token_count() << " tokens):" << std::endl;
+    for (size_t i = 0; i < histogram.size(); i++) {
+        if (histogram[i] == 0) continue;
+        std::cout << "    " << (i + 1) << (i + 1 == histogram.size() ? "+" : "")
+                  << ": " << histogram[i] << std::endl;
+    }
+
+    const NgramTable& ngrams = stats.ngrams();
+    std::cout << "  " << stats.ngram_order() << "-grams: " << ngrams.total() << " total, "
+              << ngrams.size() << " distinct" << std::endl;
+    std::vector<const NgramTable::Entry*> top = ngrams.top(TOP_NGRAMS);
+    for (size_t i = 0; i < top.size(); i++) {
+        std::cout << "    " << top[i]->count << " " << top[i]->text << std::endl;
+    }
+}
+
+// 한 라운드: 워커마다 청크 하나씩 (필요하면 직접 읽어서) 세고 파일 순서대로 병합
+bool count_round(WorkerPool& pool, const FileReader& reader, const std::vector<ChunkTask>& tasks,
+                 size_t ngrams, WordCounter& counter, TokenStats& stats, IoCounters& io) {
+    const bool with_stats = ngrams > 0;
+    std::vector<ChunkResult> results(tasks.size(), ChunkResult(ngrams));
+    pool.run([&](unsigned worker) {
+        if (worker >= tasks.size()) return;
+        const ChunkTask& task = tasks[worker];
+        ChunkResult& result = results[worker];
+        if (task.extent.hole) {
+            result.counter.process_nul_run(task.extent.size);
+            return;
+        }
+        const char* data = task.data;
+        if (data == nullptr) {
+            // 워커의 노드에 있는 버퍼로 읽어 페이지 복사와 세기가 같은 노드에서 일어나게 한다
+            char* buffer = pool.buffer(worker);
+            if (!reader.read_extent(task.extent, buffer, result.io)) {
+                result.failed = true;
+                return;
+            }
+            data = buffer;
+        }
+        count_chunk(data, task.extent.size, with_stats, result);
+    });
+
+    for (size_t i = 0; i < results.size(); i++) {
+        if (results[i].failed) return false;
+        counter.merge(results[i].counter);
+        if (with_stats) {
+            stats.merge(std::move(results[i].stats));
+        }
+        io += results[i].io;
+    }
+    return true;
+}
+
+void print_counts(const WordCounter& counter, const std::string& name) {
+    // 출력 형식: [줄 수] [단어 수] [글자 수] [파일 경로]
+    std::cout << counter.get_lines() << " "
+              << counter.get_words() << " "
+              << counter.get_chars() << " "
+              << name << std::endl;
+}
+
+bool file_exists(const std::string& path) {
+    std::ifstream probe(path);
+    return probe.is_open();
+}
+
+// 이어서 셀 위치를 정한다: 체크포인트에서 재개하거나, 지정 구간 또는 파일 전체
+bool prepare_state(const std::string& filename, uint64_t file_size, const Options& options,
+                   Checkpoint& state) {
+    state.file = filename;
+    state.file_size = file_size;
+    if (options.resume && file_exists(options.checkpoint_path)) {
+        Checkpoint saved;
+        if (!read_checkpoint(options.checkpoint_path, saved)) {
+            return false;
+        }
+        if (saved.file != filename || saved.file_size != file_size) {
+            std::cerr << "Error: Checkpoint '" << options.checkpoint_path
+                      << "' does not match file '" << filename << "'" << std::endl;
+            return false;
+        }
+        state = saved;
+    } else if (options.has_range) {
+        if (options.range_begin > file_size) {
+            std::cerr << "Error: Range starts at " << options.range_begin << ", past the end of '"
+                      << filename << "' (" << file_size << " bytes)" << std::endl;
+            return false;
+        }
+        state.begin = state.offset = options.range_begin;
+        state.end = options.range_end;
+    }
+    return true;
+}
+
+bool count_file(const std::string& filename, const Options& options, WorkerPool& pool,
+                RunStats& run_stats) {
+    if (options.stats) {
+        run_stats.start();
+    }
+
+    // 토큰 통계는 실제 바이트가 필요하므로 구멍 건너뛰기는 기본 카운트에만 쓴다
+    FileReader reader;
+    if (!reader.open(filename, options.ngrams == 0)) {
         std::cerr << "Error: Cannot open file '" << filename << "'" << std::endl;
         return false;
     }
-    
+    const bool with_checkpoint = !options.checkpoint_path.empty();
+    if (!reader.is_regular() && (with_checkpoint || options.has_range)) {
+        std::cerr << "Error: Checkpoints and ranges need a regular file: '" << filename << "'" << std::endl;
+        return false;
+    }
+    const uint64_t file_size = reader.size();
+
+    Checkpoint state;
+    if (!prepare_state(filename, file_size, options, state)) {
+        return false;
+    }
+    const uint64_t end = std::min(state.end, file_size);
+    const uint64_t start_offset = state.offset;
+
+    std::vector<char> stream_buffer(reader.is_regular() ? 0 : CHUNK_SIZE * pool.size());
+    std::vector<ChunkTask> tasks;
+    TokenStats stats(options.ngrams);
+    IoCounters worker_io;
+    uint64_t last_saved = state.offset;
+
+    // 라운드마다 워커 수만큼 청크를 정해 한 번씩만 읽는다. 구멍은 읽지 않고 길이만큼 NUL로 센다
+    while (state.offset < end) {
+        tasks.clear();
+        uint64_t planned = state.offset;
+        if (reader.is_regular()) {
+            while (tasks.size() < pool.size() && planned < end) {
+                ChunkTask task;
+                reader.next_extent(planned, end, CHUNK_SIZE, task.extent);
+                if (task.extent.size == 0) break;
+                planned += task.extent.size;
+                tasks.push_back(task);
+            }
+        } else {
+            size_t filled = 0;
+            if (!reader.read_stream(stream_buffer.data(), stream_buffer.size(), filled)) {
+                std::cerr << "Error: Failed to read file '" << filename << "'" << std::endl;
+                return false;
+            }
+            for (size_t begin = 0; begin < filled; begin += CHUNK_SIZE) {
+                ChunkTask task;
+                task.extent.offset = planned + begin;
+                task.extent.size = std::min(CHUNK_SIZE, filled - begin);
+                task.data = stream_buffer.data() + begin;
+                tasks.push_back(task);
+            }
+            planned += filled;
+        }
+        if (tasks.empty()) break;
+
+        if (!count_round(pool, reader, tasks, options.ngrams, state.counter, stats, worker_io)) {
+            std::cerr << "Error: Failed to read file '" << filename << "'" << std::endl;
+            return false;
+        }
+        state.offset = planned;
+
+        if (with_checkpoint && state.offset - last_saved >= options.checkpoint_interval) {
+            if (!write_checkpoint(options.checkpoint_path, state)) {
+                return false;
+            }
+            last_saved = state.offset;
+        }
+    }
+    reader.close();
+
+    if (reader.is_regular() && state.offset < end) {
+        std::cerr << "Error: File '" << filename << "' shrank while reading" << std::endl;
+        return false;
+    }
+
+    if (with_checkpoint && !write_checkpoint(options.checkpoint_path, state)) {
+        return false;
+    }
+
+    if (options.stats) {
+        run_stats.stop();
+    }
+
+    if (state.begin > 0 || end < file_size) {
+        // 부분 구간: 다른 구간과 병합될 수 있도록 마지막 줄을 확정하지 않고 출력
+        std::ostringstream name;
+        name << filename << ":" << state.begin << "-" << end;
+        print_counts(state.counter, name.str());
+    } else {
+        state.counter.finalize();
+        print_counts(state.counter, filename);
+
+        if (options.ngrams > 0) {
+            stats.finalize();
+            print_token_stats(stats);
+        }
+    }
+
+    if (options.stats) {
+        IoCounters io = reader.counters();
+        io += worker_io;
+        run_stats.print(std::cerr, filename, state.offset - start_offset, pool.size(), io);
+        std::cerr << "  placement        ";
+        const unsigned pinned = pool.pinned_count();
+        if (!pool.wants_pinning()) {
+            std::cerr << "unpinned" << std::endl;
+        } else if (pinned == pool.size()) {
+            std::cerr << "pinned across " << pool.node_count() << " NUMA nodes" << std::endl;
+        } else {
+            // 고정 호출이 실패한 워커는 스케줄러가 옮길 수 있으므로 따로 밝힌다
+            std::cerr << pinned << " of " << pool.size() << " workers pinned across " << pool.node_count()
+                      << " NUMA nodes, unpinned:";
+            for (unsigned i = 0; i < pool.size(); i++) {
+                if (!pool.is_pinned(i)) std::cerr << ' ' << i;
+            }
+            std::cerr << std::endl;
+        }
+    }
+
+    return true;
+}
+
+// 여러 체크포인트(인접한 구간들)를 오프셋 순서로 병합해 파일 전체 결과를 낸다
+bool merge_checkpoints(const std::vector<std::string>& paths) {
+    std::vector<Checkpoint> parts(paths.size());
+    for (size_t i = 0; i < paths.size(); i++) {
+        if (!read_checkpoint(paths[i], parts[i])) {
+            return false;
+        }
+        if (!parts[i].is_complete()) {
+            std::cerr << "Error: Checkpoint '" << paths[i] << "' is not finished (offset "
+                      << parts[i].offset << ")" << std::endl;
+            return false;
+        }
+    }
+    std::sort(parts.begin(), parts.end(), [](const Checkpoint& a, const Checkpoint& b) {
+        return a.begin < b.begin;
+    });
+
     WordCounter counter;
-    char c;
-    
-    // 한 글자씩 읽어서 처리
-    while (file.get(c)) {
-        counter.process_char(c);
-    }
-    
-    file.close();
+    uint64_t covered = 0;
+    for (size_t i = 0; i < parts.size(); i++) {
+        const Checkpoint& part = parts[i];
+        if (part.file != parts[0].file) {
+            std::cerr << "Error: Checkpoints are for different files: '" << parts[0].file
+                      << "' and '" << part.file << "'" << std::endl;
+            return false;
+        }
+        if (part.file_size != parts[0].file_size || part.begin != covered) {
+            std::cerr << "Error: Checkpoints do not cover '" << parts[0].file
+                      << "' contiguously at offset " << covered << std::endl;
+            return false;
+        }
+        counter.merge(part.counter);
+        covered = part.offset;
+    }
+    if (covered < parts[0].file_size) {
+        std::cerr << "Error: Checkpoints stop at offset " << covered << " of "
+                  << parts[0].file_size << std::endl;
+        return false;
+    }
+
     counter.finalize();
-    
-    // 출력 형식: [줄 수] [단어 수] [글자 수] [파일 경로]
-    std::cout << counter.get_lines() << " " 
-              << counter.get_words() << " " 
-              << counter.get_chars() << " " 
-              << filename << std::endl;
-    
+    print_counts(counter, parts[0].file);
     return true;
 }
 
+bool parse_size(const char* text, uint64_t& value) {
+    char* end = nullptr;
+    unsigned long long parsed = std::strtoull(text, &end, 10);
+    if (end == text || *end != '\0') return false;
+    value = static_cast<uint64_t>(parsed);
+    return true;
+}
+
+// START:END 또는 START: (파일 끝까지)
+bool parse_range(const char* text, uint64_t& begin, uint64_t& end) {
+    const char* colon = std::strchr(text, ':');
+    if (colon == nullptr) return false;
+    if (!parse_size(std::string(text, colon).c_str(), begin)) return false;
+    if (colon[1] == '\0') {
+        end = Checkpoint::TO_END;
+        return true;
+    }
+    return parse_size(colon + 1, end) && end > begin;
+}
+
+bool parse_options(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        uint64_t value = 0;
+        if (std::strncmp(arg, "--ngrams=", 9) == 0) {
+            if (!parse_size(arg + 9, value) || value < 1 || value > TokenStats::MAX_NGRAM) {
+                std::cerr << "Error: --ngrams must be between 1 and " << TokenStats::MAX_NGRAM << std::endl;
+                return false;
+            }
+            options.ngrams = static_cast<size_t>(value);
+        } else if (std::strncmp(arg, "--threads=", 10) == 0) {
+            if (!parse_size(arg + 10, value) || value < 1) {
+                std::cerr << "Error: --threads must be a positive number" << std::endl;
+                return false;
+            }
+            options.threads = static_cast<unsigned>(value);
+        } else if (std::strncmp(arg, "--checkpoint=", 13) == 0) {
+            options.checkpoint_path = arg + 13;
+        } else if (std::strncmp(arg, "--checkpoint-interval=", 22) == 0) {
+            if (!parse_size(arg + 22, value) || value < 1) {
+                std::cerr << "Error: --checkpoint-interval must be a positive byte count" << std::endl;
+                return false;
+            }
+            options.checkpoint_interval = value;
+        } else if (std::strcmp(arg, "--resume") == 0) {
+            options.resume = true;
+        } else if (std::strncmp(arg, "--range=", 8) == 0) {
+            if (!parse_range(arg + 8, options.range_begin, options.range_end)) {
+                std::cerr << "Error: --range must be START:END or START:" << std::endl;
+                return false;
+            }
+            options.has_range = true;
+        } else if (std::strcmp(arg, "--merge") == 0) {
+            options.merge = true;
+        } else if (std::strcmp(arg, "--stats") == 0) {
+            options.stats = true;
+        } else if (std::strcmp(arg, "--affinity=numa") == 0) {
+            options.placement = Placement::NUMA;
+        } else if (std::strcmp(arg, "--affinity=none") == 0) {
+            options.placement = Placement::NONE;
+        } else {
+            options.files.push_back(arg);
+        }
+    }
+    if (options.threads == 0) {
+        options.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    const bool uses_checkpoint = !options.checkpoint_path.empty() || options.has_range || options.merge;
+    if (uses_checkpoint && options.ngrams > 0) {
+        std::cerr << "Error: --ngrams cannot be combined with checkpoints, ranges or --merge" << std::endl;
+        return false;
+    }
+    if (options.resume && options.checkpoint_path.empty()) {
+        std::cerr << "Error: --resume requires --checkpoint=FILE" << std::endl;
+        return false;
+    }
+    if (!options.checkpoint_path.empty() && options.files.size() > 1 && !options.merge) {
+        std::cerr << "Error: --checkpoint takes exactly one input file" << std::endl;
+        return false;
+    }
+    return !options.files.empty();
+}
+
+} // namespace
+
 int main(int argc, char* argv[]) {
-    if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " <file1> [file2] ..." << std::endl;
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " [--ngrams=N] [--threads=N] [--affinity=numa|none] [--stats] <file1> [file2] ...\n"
+                  << "       " << argv[0] << " --checkpoint=FILE [--checkpoint-interval=BYTES] [--resume]"
+                  << " [--range=START:END] <file>\n"
+                  << "       " << argv[0] << " --merge <checkpoint1> [checkpoint2] ..." << std::endl;
         return 1;
     }
-    
+
+    if (options.merge) {
+        return merge_checkpoints(options.files) ? 0 : 1;
+    }
+
+    // 하드웨어 카운터가 워커 스레드를 따라가도록 풀을 만들기 전에 연다
+    RunStats run_stats;
+    if (options.stats) {
+        run_stats.open_counters();
+    }
+    WorkerPool pool(options.threads, CHUNK_SIZE, options.placement);
     bool all_success = true;
-    
-    for (int i = 1; i < argc; i++) {
-        if (!count_file(argv[i])) {
+
+    for (size_t i = 0; i < options.files.size(); i++) {
+        if (!count_file(options.files[i], options, pool, run_stats)) {
             all_success = false;
         }
     }
-    
+
     return all_success ? 0 : 1;
 }
@@ -0,0 +1,107 @@
+#include "numa.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+// "0-3,8-11" 형식의 CPU 목록
+std::vector<int> parse_cpu_list(const std::string& text) {
+    std::vector<int> cpus;
+    std::stringstream stream(text);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        if (range.empty() || range == "\n") continue;
+        const size_t dash = range.find('-');
+        const int first = std::atoi(range.c_str());
+        const int last = dash == std::string::npos ? first : std::atoi(range.c_str() + dash + 1);
+        for (int cpu = first; cpu <= last; cpu++) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+#ifdef __linux__
+std::vector<int> allowed_cpus() {
+    std::vector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+        return cpus;
+    }
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+    }
+    return cpus;
+}
+#endif
+
+} // namespace
+
+std::vector<NumaNode> discover_numa_nodes() {
+    std::vector<NumaNode> nodes;
+#ifdef __linux__
+    const std::vector<int> allowed = allowed_cpus();
+    std::vector<bool> is_allowed;
+    for (size_t i = 0; i < allowed.size(); i++) {
+        if (static_cast<size_t>(allowed[i]) >= is_allowed.size()) {
+            is_allowed.resize(allowed[i] + 1, false);
+        }
+        is_allowed[allowed[i]] = true;
+    }
+
+    // 노드 번호는 연속이 아닐 수 있으므로 넉넉히 훑는다
+    for (int id = 0; id < 1024; id++) {
+        std::ostringstream path;
+        path << "/sys/devices/system/node/node" << id << "/cpulist";
+        std::ifstream file(path.str());
+        if (!file.is_open()) continue;
+
+        std::string text;
+        std::getline(file, text);
+        NumaNode node;
+        node.id = id;
+        const std::vector<int> cpus = parse_cpu_list(text);
+        for (size_t i = 0; i < cpus.size(); i++) {
+            if (static_cast<size_t>(cpus[i]) < is_allowed.size() && is_allowed[cpus[i]]) {
+                node.cpus.push_back(cpus[i]);
+            }
+        }
+        if (!node.cpus.empty()) {
+            nodes.push_back(node);
+        }
+    }
+
+    if (nodes.empty()) {
+        NumaNode node;
+        node.cpus = allowed;
+        nodes.push_back(node);
+    }
+#else
+    nodes.push_back(NumaNode());
+#endif
+    return nodes;
+}
+
+bool pin_current_thread(const std::vector<int>& cpus) {
+#ifdef __linux__
+    if (cpus.empty()) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (size_t i = 0; i < cpus.size(); i++) {
+        CPU_SET(cpus[i], &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <vector>
+
+// NUMA 노드 하나와 이 프로세스가 그 노드에서 쓸 수 있는 CPU 목록
+struct NumaNode {
+    int id = 0;
+    std::vector<int> cpus;
+};
+
+// 허용된 CPU(sched_getaffinity)를 /sys/devices/system/node 기준으로 노드별로 묶는다.
+// NUMA 정보가 없거나 리눅스가 아니면 모든 CPU를 담은 노드 하나를 돌려준다.
+std::vector<NumaNode> discover_numa_nodes();
+
+// 현재 스레드를 cpus 중 하나에서만 실행되도록 고정한다
+bool pin_current_thread(const std::vector<int>& cpus);
@@ -0,0 +1,163 @@
+#include "run_stats.h"
+
+#include <cstring>
+#include <iomanip>
+#include <ostream>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+namespace {
+
+double seconds(const struct timeval& tv) {
+    return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1e6;
+}
+
+#ifdef __linux__
+int open_counter(uint64_t config) {
+    struct perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.inherit = 1;          // 연 뒤에 만들어지는 워커 스레드까지 포함 (이미 있는 스레드는 제외)
+    attr.exclude_kernel = 1;   // 권한이 낮아도 열 수 있도록 사용자 공간만
+    attr.exclude_hv = 1;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+#endif
+
+} // namespace
+
+RunStats::RunStats() {
+    for (int i = 0; i < HW_COUNTER_COUNT; i++) {
+        hw_fds_[i] = -1;
+        hw_values_[i] = 0;
+    }
+}
+
+RunStats::~RunStats() {
+    close_hw_counters();
+}
+
+RunStats::Usage RunStats::read_usage() {
+    Usage usage;
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) == 0) {
+        usage.user_seconds = seconds(ru.ru_utime);
+        usage.system_seconds = seconds(ru.ru_stime);
+        usage.minor_faults = ru.ru_minflt;
+        usage.major_faults = ru.ru_majflt;
+        usage.voluntary_switches = ru.ru_nvcsw;
+        usage.involuntary_switches = ru.ru_nivcsw;
+    }
+    return usage;
+}
+
+void RunStats::open_counters() {
+#ifdef __linux__
+    const uint64_t configs[HW_COUNTER_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES
+    };
+    hw_available_ = true;
+    for (int i = 0; i < HW_COUNTER_COUNT; i++) {
+        hw_fds_[i] = open_counter(configs[i]);
+        if (hw_fds_[i] < 0) {
+            hw_available_ = false;
+        }
+    }
+    if (!hw_available_) {
+        close_hw_counters();
+    }
+#endif
+}
+
+void RunStats::close_hw_counters() {
+    for (int i = 0; i < HW_COUNTER_COUNT; i++) {
+        if (hw_fds_[i] >= 0) {
+            close(hw_fds_[i]);
+            hw_fds_[i] = -1;
+        }
+    }
+}
+
+void RunStats::start() {
+#ifdef __linux__
+    for (int i = 0; hw_available_ && i < HW_COUNTER_COUNT; i++) {
+        ioctl(hw_fds_[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(hw_fds_[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+    start_usage_ = read_usage();
+    start_time_ = std::chrono::steady_clock::now();
+}
+
+void RunStats::stop() {
+    stop_time_ = std::chrono::steady_clock::now();
+    stop_usage_ = read_usage();
+#ifdef __linux__
+    for (int i = 0; hw_available_ && i < HW_COUNTER_COUNT; i++) {
+        ioctl(hw_fds_[i], PERF_EVENT_IOC_DISABLE, 0);
+        uint64_t value = 0;
+        if (read(hw_fds_[i], &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value))) {
+            hw_available_ = false;
+        }
+        hw_values_[i] = value;
+    }
+#endif
+}
+
+void RunStats::print(std::ostream& out, const std::string& name, uint64_t bytes,
+                     unsigned threads, const IoCounters& io) const {
+    const double wall = std::chrono::duration<double>(stop_time_ - start_time_).count();
+    const double user = stop_usage_.user_seconds - start_usage_.user_seconds;
+    const double system = stop_usage_.system_seconds - start_usage_.system_seconds;
+    const double mb_per_second = wall > 0 ? static_cast<double>(bytes) / wall / 1e6 : 0;
+
+    std::ios::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(3);
+    out << "stats for " << name << ":\n"
+        << "  wall time        " << wall << " s\n"
+        << "  throughput       " << std::setprecision(1) << mb_per_second << " MB/s ("
+        << bytes << " bytes, " << io.bytes_read << " read, " << io.hole_bytes << " in holes)\n"
+        << std::setprecision(3)
+        << "  cpu time         user " << user << " s, sys " << system << " s\n";
+    if (wall > 0) {
+        // 1에 가까우면 CPU 한 개 분량만 썼다는 뜻: threads보다 훨씬 작으면 I/O 대기가 많다
+        out << "  cpu utilization  " << std::setprecision(2) << (user + system) / wall
+            << " of " << threads << " threads\n";
+    }
+    out << "  syscalls         open " << io.opens << ", read " << io.reads
+        << ", lseek " << io.seeks << "\n"
+        << "  page faults      minor " << (stop_usage_.minor_faults - start_usage_.minor_faults)
+        << ", major " << (stop_usage_.major_faults - start_usage_.major_faults) << "\n"
+        << "  context switches voluntary "
+        << (stop_usage_.voluntary_switches - start_usage_.voluntary_switches)
+        << ", involuntary "
+        << (stop_usage_.involuntary_switches - start_usage_.involuntary_switches) << "\n";
+    if (hw_available_) {
+        out << "  cycles           " << hw_values_[CYCLES] << "\n"
+            << "  instructions     " << hw_values_[INSTRUCTIONS];
+        if (hw_values_[CYCLES] > 0) {
+            out << " (IPC " << std::setprecision(2)
+                << static_cast<double>(hw_values_[INSTRUCTIONS]) / static_cast<double>(hw_values_[CYCLES])
+                << ")";
+        }
+        out << "\n"
+            << "  cache misses     " << hw_values_[CACHE_MISSES] << "\n";
+        if (bytes > 0) {
+            out << "  cycles per byte  " << std::setprecision(2)
+                << static_cast<double>(hw_values_[CYCLES]) / static_cast<double>(bytes) << "\n";
+        }
+    } else {
+        out << "  hardware counters unavailable (perf_event_open not permitted)\n";
+    }
+    out.flags(flags);
+    out << std::flush;
+}
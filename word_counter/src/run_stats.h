@@ -0,0 +1,70 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+// 입력 읽기에 쓴 시스템 콜과 바이트 수 (FileReader가 호출할 때마다 센다)
+struct IoCounters {
+    uint64_t opens = 0;
+    uint64_t reads = 0;        // read/pread 호출 수
+    uint64_t seeks = 0;        // SEEK_DATA/SEEK_HOLE lseek 호출 수
+    uint64_t bytes_read = 0;
+    uint64_t hole_bytes = 0;   // 읽지 않고 센 구멍 바이트
+
+    IoCounters& operator+=(const IoCounters& other) {
+        opens += other.opens;
+        reads += other.reads;
+        seeks += other.seeks;
+        bytes_read += other.bytes_read;
+        hole_bytes += other.hole_bytes;
+        return *this;
+    }
+};
+
+// --stats: 한 번의 실행에 대한 성능 카운터
+//
+// 시작/끝에서만 값을 읽으므로 세는 루프에는 비용이 없다. 하드웨어 카운터는
+// perf_event_open이 허용될 때만(perf_event_paranoid, 컨테이너 등) 수집한다.
+// 카운터는 여는 시점 이후에 만들어진 스레드만 따라가므로(inherit) 워커 스레드보다
+// 먼저 open_counters()로 열어 두고, 파일마다 start()/stop()으로 다시 센다.
+class RunStats {
+public:
+    RunStats();
+    ~RunStats();
+
+    RunStats(const RunStats&) = delete;
+    RunStats& operator=(const RunStats&) = delete;
+
+    void open_counters();
+    void start();
+    void stop();
+
+    void print(std::ostream& out, const std::string& name, uint64_t bytes,
+               unsigned threads, const IoCounters& io) const;
+
+private:
+    enum { CYCLES, INSTRUCTIONS, CACHE_MISSES, HW_COUNTER_COUNT };
+
+    struct Usage {
+        double user_seconds = 0;
+        double system_seconds = 0;
+        long minor_faults = 0;
+        long major_faults = 0;
+        long voluntary_switches = 0;
+        long involuntary_switches = 0;
+    };
+
+    std::chrono::steady_clock::time_point start_time_;
+    std::chrono::steady_clock::time_point stop_time_;
+    Usage start_usage_;
+    Usage stop_usage_;
+
+    int hw_fds_[HW_COUNTER_COUNT];
+    uint64_t hw_values_[HW_COUNTER_COUNT];
+    bool hw_available_ = false;
+
+    static Usage read_usage();
+    void close_hw_counters();
+};
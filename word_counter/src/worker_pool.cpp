@@ -0,0 +1,89 @@
+#include "worker_pool.h"
+#include "numa.h"
+
+WorkerPool::WorkerPool(unsigned threads, size_t buffer_size, Placement placement)
+    : workers_(threads), buffer_size_(buffer_size) {
+    if (placement == Placement::NUMA) {
+        const std::vector<NumaNode> nodes = discover_numa_nodes();
+        // 노드가 하나뿐이면 고정해도 얻는 것이 없으므로 스케줄러에 맡긴다
+        if (nodes.size() > 1) {
+            node_count_ = nodes.size();
+            wants_pinning_ = true;
+            for (unsigned i = 0; i < threads; i++) {
+                // 워커를 노드 순서대로 고르게 나눠 인접 워커가 같은 노드를 쓰게 한다
+                const size_t node = static_cast<size_t>(i) * nodes.size() / threads;
+                workers_[i].cpus = nodes[node].cpus;
+            }
+        }
+    }
+
+    starting_ = threads;
+    for (unsigned i = 0; i < threads; i++) {
+        workers_[i].thread = std::thread(&WorkerPool::worker_loop, this, i);
+    }
+    // 워커마다 고정 결과가 정해질 때까지 기다려 is_pinned가 실제 배치를 보고하게 한다
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this]() { return starting_ == 0; });
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    start_.notify_all();
+    for (size_t i = 0; i < workers_.size(); i++) {
+        workers_[i].thread.join();
+    }
+}
+
+unsigned WorkerPool::pinned_count() const {
+    unsigned count = 0;
+    for (size_t i = 0; i < workers_.size(); i++) {
+        if (workers_[i].pinned) count++;
+    }
+    return count;
+}
+
+void WorkerPool::run(const std::function<void(unsigned)>& job) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    job_ = &job;
+    pending_ = size();
+    generation_++;
+    start_.notify_all();
+    done_.wait(lock, [this]() { return pending_ == 0; });
+    job_ = nullptr;
+}
+
+void WorkerPool::worker_loop(unsigned index) {
+    Worker& worker = workers_[index];
+    const bool pinned = !worker.cpus.empty() && pin_current_thread(worker.cpus);
+    // 고정한 뒤에 할당하고 0으로 채워 페이지를 이 노드에서 폴트시킨다
+    worker.buffer.assign(buffer_size_, 0);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        worker.pinned = pinned;
+        if (--starting_ == 0) {
+            done_.notify_one();
+        }
+    }
+
+    uint64_t seen = 0;
+    for (;;) {
+        const std::function<void(unsigned)>* job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_.wait(lock, [&]() { return stopping_ || generation_ != seen; });
+            if (stopping_) return;
+            seen = generation_;
+            job = job_;
+        }
+
+        (*job)(index);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--pending_ == 0) {
+            done_.notify_one();
+        }
+    }
+}
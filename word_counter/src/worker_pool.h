@@ -0,0 +1,67 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 워커 스레드 배치 방식
+enum class Placement {
+    NONE,  // 운영체제 스케줄러에 맡긴다
+    NUMA   // 워커를 NUMA 노드에 고정하고 노드별로 연속된 청크를 맡긴다
+};
+
+// 청크를 세는 상주 워커 스레드 묶음
+//
+// 워커 i는 라운드마다 i번째 청크를 맡는다. NUMA 배치에서는 인접한 워커가 같은 노드에
+// 고정되므로 블록이 노드별 연속 구간으로 나뉜다. 각 워커의 읽기 버퍼는 고정된 뒤
+// 그 워커가 직접 할당하고 처음 건드리므로(first touch) 워커의 노드 메모리에 놓인다.
+class WorkerPool {
+public:
+    WorkerPool(unsigned threads, size_t buffer_size, Placement placement);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(workers_.size()); }
+    size_t node_count() const { return node_count_; }
+    // NUMA 배치로 노드에 고정하려 했는지 (실제 고정 여부는 is_pinned로 워커마다 확인)
+    bool wants_pinning() const { return wants_pinning_; }
+    // 워커 worker의 고정 호출이 성공했는지 (생성자가 돌아온 뒤에는 바뀌지 않는다)
+    bool is_pinned(unsigned worker) const { return workers_[worker].pinned; }
+    unsigned pinned_count() const;
+
+    // 워커 자신의 버퍼 (job 안에서 그 워커만 사용)
+    char* buffer(unsigned worker) { return workers_[worker].buffer.data(); }
+
+    // 모든 워커가 job(worker)을 한 번씩 실행할 때까지 기다린다
+    void run(const std::function<void(unsigned)>& job);
+
+private:
+    struct Worker {
+        std::thread thread;
+        std::vector<int> cpus;     // 비어 있으면 고정하지 않음
+        std::vector<char> buffer;
+        bool pinned = false;       // pin_current_thread가 성공했을 때만 true
+    };
+
+    std::vector<Worker> workers_;
+    size_t buffer_size_;
+    size_t node_count_ = 1;
+    bool wants_pinning_ = false;
+
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    const std::function<void(unsigned)>* job_ = nullptr;
+    uint64_t generation_ = 0;
+    unsigned pending_ = 0;
+    unsigned starting_ = 0;        // 아직 고정과 버퍼 준비를 마치지 않은 워커 수
+    bool stopping_ = false;
+
+    void worker_loop(unsigned index);
+};